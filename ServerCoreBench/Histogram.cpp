@@ -0,0 +1,95 @@
+#include "pch.h"
+#include "Histogram.h"
+#include <bit>
+#include <cstdio>
+
+LatencyHistogram::LatencyHistogram()
+    : _counts(BUCKET_COUNT, 0)
+{
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    _counts[IndexOf(value)]++;
+    _count++;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    for (int32_t i = 0; i < BUCKET_COUNT; i++)
+        _counts[i] += other._counts[i];
+
+    _count += other._count;
+    _sum += other._sum;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+}
+
+void LatencyHistogram::Reset()
+{
+    std::fill(_counts.begin(), _counts.end(), 0);
+    _count = 0;
+    _sum = 0;
+    _min = UINT64_MAX;
+    _max = 0;
+}
+
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+    if (_count == 0)
+        return 0;
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(percentile / 100.0 * _count + 0.5));
+
+    uint64_t seen = 0;
+    for (int32_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += _counts[i];
+        if (seen >= target)
+            return std::min(HighestValueAt(i), _max);
+    }
+
+    return _max;
+}
+
+std::string LatencyHistogram::ToJson(double scale) const
+{
+    char json[320];
+    ::snprintf(json, sizeof(json),
+        "{\"count\":%llu,\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"p999\":%.3f,\"max\":%.3f,\"mean\":%.3f}",
+        static_cast<unsigned long long>(_count),
+        Min() * scale,
+        ValueAtPercentile(50.0) * scale,
+        ValueAtPercentile(90.0) * scale,
+        ValueAtPercentile(99.0) * scale,
+        ValueAtPercentile(99.9) * scale,
+        Max() * scale,
+        Mean() * scale);
+    return json;
+}
+
+int32_t LatencyHistogram::IndexOf(uint64_t value)
+{
+    if (value < SUB_BUCKET_COUNT)
+        return static_cast<int32_t>(value);
+
+    // value >> shift  [64, 128)   ڸ
+    const int32_t msb = 63 - std::countl_zero(value);
+    const int32_t shift = std::min<int32_t>(msb - (SUB_BUCKET_BITS - 1), MAX_VALUE_BITS - SUB_BUCKET_BITS);
+    const int32_t sub = static_cast<int32_t>(std::min<uint64_t>(value >> shift, SUB_BUCKET_COUNT - 1));
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF + (sub - SUB_BUCKET_HALF);
+}
+
+uint64_t LatencyHistogram::HighestValueAt(int32_t index)
+{
+    if (index < SUB_BUCKET_COUNT)
+        return static_cast<uint64_t>(index);
+
+    const int32_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1;
+    const uint64_t sub = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF;
+    return ((sub + 1) << shift) - 1;
+}
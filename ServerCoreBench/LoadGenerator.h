@@ -0,0 +1,797 @@
+#pragma once
+#include "Session.h"
+#include "CoroutineSession.h"
+#include "Histogram.h"
+#include "AsioCore.h"
+
+class NetAddress;
+
+enum class LoadScenario : uint8_t
+{
+    Echo,       // Ḷ pipelineDepth   ΰ, ƿ  ٽ  (ó)
+    PingPong,   // Ḷ ϳ ְ޴´ (պ )
+    Broadcast,  // ù   Ŷ   ῡ Ѹ (fan-out )
+    Churn,      //  ->   ְޱ -> ⸦ ݺѴ ( ó)
+};
+
+enum class LoadServerMode : uint8_t
+{
+    Callback,   // LoadServerSession (Ŷ OnRecvPacket)
+    Batch,      // LoadBatchServerSession (OnRecvPackets)
+    Coroutine,  // LoadCoroutineServerSession
+};
+
+enum : uint16_t
+{
+    LOAD_PACKET_ECHO = 0xFF01,
+    LOAD_PACKET_BROADCAST = 0xFF02,
+};
+
+enum : uint64_t
+{
+    LOAD_BROADCAST_GROUP = 0xFFFFFFFF,
+};
+
+struct LoadOptions
+{
+    LoadScenario    scenario = LoadScenario::Echo;
+    int32_t         connectionCount = 100;
+    int32_t         packetSize = 64;        //  . ּ 16Ʈ ( 4 +  ð 8 +  ± 4)
+    int32_t         pipelineDepth = 8;      // Echo   ÿ   Ŷ 
+    int32_t         threadCount = 2;        // Ŭ̾Ʈ I/O  (帶  ϳ)
+    int32_t         durationMs = 5000;
+    CompressionOptions compression;         // Ѹ (LoadServerOptions::compression)  ̾ Ѵ
+};
+
+//  μ  LoadServer   (LoadServer::GetResult)
+struct LoadServerResult
+{
+    LoadServerMode      mode = LoadServerMode::Callback;
+    SendFlushMode       flushMode = SendFlushMode::Immediate;
+    int32_t             flushWindowUs = 0;
+
+    //  I/O 尡    ( /   )
+    double              elapsedSec = 0.0;
+    uint64_t            packets = 0;            //  Ŷ 
+    uint64_t            sendCalls = 0;          //   ȣ 
+    uint64_t            recvCalls = 0;          //  б ȣ 
+};
+
+struct LoadResult
+{
+    LoadOptions         options;
+    LoadServerResult    server;                 // LoadGenerator  ä ʴ´
+    int32_t             connectedCount = 0;     //     ִ 
+    uint64_t            packets = 0;            //  Ŷ 
+    uint64_t            bytes = 0;              //  Ʈ 
+    uint64_t            connects = 0;           //   
+    double              elapsedSec = 0.0;
+    LatencyHistogram    latency;                // ns
+    LatencyHistogram    connectLatency;         // ns
+
+    //     (μ ü  μ LoadServer  )
+    uint64_t            compressInputBytes = 0;
+    uint64_t            compressOutputBytes = 0;
+    uint64_t            compressNs = 0;
+    uint64_t            decompressNs = 0;
+
+    //  us 
+    std::string ToJson() const;
+};
+
+/*---------------------
+    LoadServerSession
+----------------------*/
+// LoadGenerator . ServerService   丮 
+// ECHO  ״ ְ, BROADCAST   LOAD_BROADCAST_GROUP ü Ѹ
+class LoadServerSession : public PacketSession
+{
+public:
+    LoadServerSession(asio::io_context& ioc) : PacketSession(ioc) {}
+
+protected:
+    virtual void OnConnected() override;
+    virtual void OnRecvPacket(BYTE* buffer, int32_t len) override;
+};
+
+/*--------------------------
+    LoadBatchServerSession
+---------------------------*/
+// LoadServerSession    OnRecvPackets  Ѵ (Ŷ óϴ ο ġ θ  Ϸ Ϸ)
+//    ECHO Ŷ  Send   ť ִ´
+class LoadBatchServerSession : public PacketSession
+{
+public:
+    LoadBatchServerSession(asio::io_context& ioc) : PacketSession(ioc) {}
+
+protected:
+    virtual void OnConnected() override;
+    virtual void OnRecvPackets(std::span<const PacketView> packets) override;
+
+private:
+    std::vector<std::shared_ptr<SendBuffer>> _replies;    // ġ  ٽ 
+};
+
+/*------------------------------
+    LoadCoroutineServerSession
+-------------------------------*/
+// LoadServerSession    CoroutineSession  Ѵ (ڷƾ ο ݹ θ  Ϸ Ϸ)
+class LoadCoroutineServerSession : public CoroutineSession
+{
+public:
+    LoadCoroutineServerSession(asio::io_context& ioc) : CoroutineSession(ioc) {}
+
+protected:
+    virtual void OnConnected() override;
+    virtual asio::awaitable<void> Run() override;
+};
+
+/*--------------
+    LoadServer
+---------------*/
+struct LoadServerOptions
+{
+    int32_t             threadCount = 2;        //   I/O  
+    int32_t             shardCount = 0;         // 0 ̸  io_context ϳ, N ̸   (帶  ϳ, threadCount  )
+    ShardPolicy         shardPolicy = ShardPolicy::RoundRobin;
+    int32_t             maxSessionCount = 20000;
+    CompressionOptions  compression;
+    LoadServerMode      mode = LoadServerMode::Callback;
+    SendFlushMode       flushMode = SendFlushMode::Immediate;   // Service::SetSendFlushPolicy
+    int32_t             flushWindowUs = 0;                      // flushMode  Window   
+};
+
+// LoadServerOptions::mode   ޴   μ ȿ  ( 񱳸   ȿ Ϸ)
+// ex) LoadServer server(serverOptions);
+//     server.Start(address);
+//     LoadResult result = LoadGenerator(options).Run(address);
+//     server.Stop();
+class LoadServer
+{
+public:
+    LoadServer(const LoadServerOptions& options);
+    ~LoadServer();
+
+    bool Start(const NetAddress& address);
+    void Stop();
+
+    // Stop ڿ θ
+    LoadServerResult GetResult() const;
+
+private:
+    LoadServerOptions               _options;
+    std::unique_ptr<class AsiocCore> _core;
+    std::shared_ptr<ServerService>  _service;
+    std::vector<std::thread>        _threads;
+
+    std::mutex                      _lock;
+    LoadServerResult                _result;    // I/O 尡   ڱ  Ѵ
+    std::chrono::steady_clock::time_point _startTime;
+};
+
+/*-----------------
+    LoadGenerator
+------------------*/
+// ClientService  ϸ   / ó 
+// ex) LoadGenerator generator(options);
+//     std::cout << generator.Run(NetAddress("127.0.0.1", 7777)).ToJson();
+class LoadGenerator
+{
+    friend class LoadClientSession;
+
+public:
+    LoadGenerator(const LoadOptions& options);
+    ~LoadGenerator();
+
+    // durationMs  ϸ ְ  ش (ȣ  ٸ)
+    LoadResult Run(const NetAddress& target);
+
+private:
+    struct alignas(64) ThreadStats
+    {
+        LatencyHistogram    latency;
+        LatencyHistogram    connectLatency;
+        uint64_t            packets = 0;
+        uint64_t            bytes = 0;
+        uint64_t            connects = 0;
+    };
+
+    static uint64_t         NowNs();
+    static ThreadStats*     LocalStats();
+
+    std::shared_ptr<SendBuffer> MakePacket(uint16_t id);
+    SessionRef              CreateSession(asio::io_context& ioc);
+    void                    Reconnect(std::shared_ptr<Service> service);
+
+private:
+    LoadOptions                                 _options;
+    std::atomic<bool>                           _running = false;
+    std::atomic<bool>                           _hasBroadcaster = false;
+    std::vector<std::unique_ptr<ThreadStats>>   _stats;
+    std::vector<BYTE>                           _payload;   // Ŷ  (̸   ä д)
+
+    std::mutex                                  _lock;
+    std::vector<std::weak_ptr<Session>>         _sessions;
+};
+
+================================================================================
+// LoadGenerator.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "LoadGenerator.h"
+#include "Service.h"
+#include "SendBuffer.h"
+#include "AsioCore.h"
+#include "ThreadManager.h"
+#include <cstdio>
+#include <cstddef>
+
+namespace
+{
+    //  ڿ ٴ .  ð ״ ޾  
+    struct LoadPacketBody
+    {
+        uint64_t sendTimeNs;
+        uint32_t sessionTag;
+    };
+
+    // ü  е 4Ʈ  ʴ´ (16Ʈ Ŷ   ְ)
+    constexpr int32_t LOAD_PACKET_BODY_SIZE = offsetof(LoadPacketBody, sessionTag) + sizeof(uint32_t);
+    constexpr int32_t MIN_LOAD_PACKET_SIZE = sizeof(PacketHeader) + LOAD_PACKET_BODY_SIZE;
+
+    thread_local void* LLoadStats = nullptr;
+
+    std::atomic<uint32_t> GLoadSessionTag = 0;
+
+    const char* ToString(CompressionCodec codec)
+    {
+        switch (codec)
+        {
+        case CompressionCodec::Lz4:     return "lz4";
+        case CompressionCodec::Zstd:    return "zstd";
+        default:                        return "none";
+        }
+    }
+
+    //  0  ä    ǹǷ   迭 ϰ ä
+    // 16Ʈ ڵ帶 [ 4][ ± 4][   ǻ  8]
+    void FillPayload(BYTE* payload, int32_t size)
+    {
+        uint32_t seed = 0x9E3779B9;
+        for (int32_t i = 0; i < size; i++)
+        {
+            const int32_t field = i % 16;
+            if (field < 4)
+            {
+                payload[i] = static_cast<BYTE>((i / 16) >> (field * 8));
+            }
+            else if (field < 8)
+            {
+                payload[i] = "unit"[field - 4];
+            }
+            else
+            {
+                seed = seed * 1664525 + 1013904223;
+                payload[i] = static_cast<BYTE>('a' + ((seed >> 24) & 0x0F));
+            }
+        }
+    }
+
+    //  Ŷ ״  
+    std::shared_ptr<SendBuffer> CopyPacket(const BYTE* buffer, int32_t len)
+    {
+        std::shared_ptr<SendBuffer> sendBuffer = GSendBufferManager->Open(len);
+        ::memcpy(sendBuffer->Buffer(), buffer, len);
+        sendBuffer->Close(len);
+        return sendBuffer;
+    }
+
+    const char* ToString(LoadScenario scenario)
+    {
+        switch (scenario)
+        {
+        case LoadScenario::Echo:        return "echo";
+        case LoadScenario::PingPong:    return "pingpong";
+        case LoadScenario::Broadcast:   return "broadcast";
+        case LoadScenario::Churn:       return "churn";
+        default:                        return "unknown";
+        }
+    }
+
+    const char* ToString(SendFlushMode mode)
+    {
+        switch (mode)
+        {
+        case SendFlushMode::Immediate:      return "immediate";
+        case SendFlushMode::EndOfHandler:   return "endofhandler";
+        case SendFlushMode::Window:         return "window";
+        default:                            return "unknown";
+        }
+    }
+
+    const char* ToString(LoadServerMode mode)
+    {
+        switch (mode)
+        {
+        case LoadServerMode::Callback:  return "callback";
+        case LoadServerMode::Batch:     return "batch";
+        case LoadServerMode::Coroutine: return "coroutine";
+        default:                        return "unknown";
+        }
+    }
+}
+
+/*---------------------
+    LoadClientSession
+----------------------*/
+class LoadClientSession : public PacketSession
+{
+public:
+    LoadClientSession(asio::io_context& ioc, LoadGenerator* generator)
+        : PacketSession(ioc), _generator(generator), _connectStartNs(LoadGenerator::NowNs()), _tag(++GLoadSessionTag)
+    {
+    }
+
+protected:
+    virtual void OnConnected() override
+    {
+        LoadGenerator::ThreadStats* stats = LoadGenerator::LocalStats();
+        stats->connects++;
+        stats->connectLatency.Record(LoadGenerator::NowNs() - _connectStartNs);
+
+        switch (_generator->_options.scenario)
+        {
+        case LoadScenario::Echo:
+            for (int32_t i = 0; i < _generator->_options.pipelineDepth; i++)
+                SendPacket(LOAD_PACKET_ECHO);
+            break;
+        case LoadScenario::Broadcast:
+            // ó   ϳ , ڱ  ƿ   
+            if (_generator->_hasBroadcaster.exchange(true) == false)
+            {
+                _broadcaster = true;
+                SendPacket(LOAD_PACKET_BROADCAST);
+            }
+            break;
+        default:
+            SendPacket(LOAD_PACKET_ECHO);
+            break;
+        }
+    }
+
+    virtual void OnRecvPacket(BYTE* buffer, int32_t len) override
+    {
+        if (len < MIN_LOAD_PACKET_SIZE)
+            return;
+
+        LoadPacketBody body;
+        ::memcpy(&body, buffer + sizeof(PacketHeader), LOAD_PACKET_BODY_SIZE);
+
+        LoadGenerator::ThreadStats* stats = LoadGenerator::LocalStats();
+        stats->latency.Record(LoadGenerator::NowNs() - body.sendTimeNs);
+        stats->packets++;
+        stats->bytes += len;
+
+        if (_generator->_running.load(std::memory_order_relaxed) == false)
+            return;
+
+        switch (_generator->_options.scenario)
+        {
+        case LoadScenario::Broadcast:
+            if (_broadcaster && body.sessionTag == _tag)
+                SendPacket(LOAD_PACKET_BROADCAST);
+            break;
+        case LoadScenario::Churn:
+            Disconnect("Load Churn");
+            _generator->Reconnect(GetService());
+            break;
+        default:
+            SendPacket(LOAD_PACKET_ECHO);
+            break;
+        }
+    }
+
+private:
+    void SendPacket(uint16_t id)
+    {
+        std::shared_ptr<SendBuffer> sendBuffer = _generator->MakePacket(id);
+
+        LoadPacketBody body{ LoadGenerator::NowNs(), _tag };
+        ::memcpy(sendBuffer->Buffer() + sizeof(PacketHeader), &body, LOAD_PACKET_BODY_SIZE);
+        Send(std::move(sendBuffer));
+    }
+
+private:
+    LoadGenerator*  _generator;
+    uint64_t        _connectStartNs;
+    uint32_t        _tag;           //  ޾    
+    bool            _broadcaster = false;
+};
+
+/*---------------------
+    LoadServerSession
+----------------------*/
+void LoadServerSession::OnConnected()
+{
+    if (auto service = GetService())
+        service->GetOrCreateGroup(LOAD_BROADCAST_GROUP)->Join(GetSessionRef());
+}
+
+void LoadServerSession::OnRecvPacket(BYTE* buffer, int32_t len)
+{
+    std::shared_ptr<SendBuffer> sendBuffer = CopyPacket(buffer, len);
+
+    PacketHeader header;
+    ::memcpy(&header, buffer, sizeof(header));
+
+    if (header.id == LOAD_PACKET_BROADCAST)
+    {
+        if (auto service = GetService())
+            service->Broadcast(LOAD_BROADCAST_GROUP, std::move(sendBuffer));
+        return;
+    }
+
+    Send(std::move(sendBuffer));
+}
+
+/*--------------------------
+    LoadBatchServerSession
+---------------------------*/
+void LoadBatchServerSession::OnConnected()
+{
+    if (auto service = GetService())
+        service->GetOrCreateGroup(LOAD_BROADCAST_GROUP)->Join(GetSessionRef());
+}
+
+void LoadBatchServerSession::OnRecvPackets(std::span<const PacketView> packets)
+{
+    for (const PacketView& packet : packets)
+    {
+        std::shared_ptr<SendBuffer> sendBuffer = CopyPacket(packet.buffer, packet.size);
+        if (packet.id == LOAD_PACKET_BROADCAST)
+        {
+            if (auto service = GetService())
+                service->Broadcast(LOAD_BROADCAST_GROUP, std::move(sendBuffer));
+            continue;
+        }
+
+        //  Send   ܰ踦 ġ Ƿ   ϳ 
+        if (IsCompressionEnabled())
+            Send(std::move(sendBuffer));
+        else
+            _replies.push_back(std::move(sendBuffer));
+    }
+
+    if (_replies.empty() == false)
+    {
+        Send(_replies);
+        _replies.clear();
+    }
+}
+
+/*------------------------------
+    LoadCoroutineServerSession
+-------------------------------*/
+void LoadCoroutineServerSession::OnConnected()
+{
+    if (auto service = GetService())
+        service->GetOrCreateGroup(LOAD_BROADCAST_GROUP)->Join(GetSessionRef());
+}
+
+asio::awaitable<void> LoadCoroutineServerSession::Run()
+{
+    while (true)
+    {
+        PacketView packet = co_await ReadPacket();
+        if (packet.buffer == nullptr)
+            co_return;
+
+        std::shared_ptr<SendBuffer> sendBuffer = CopyPacket(packet.buffer, packet.size);
+        if (packet.id == LOAD_PACKET_BROADCAST)
+        {
+            if (auto service = GetService())
+                service->Broadcast(LOAD_BROADCAST_GROUP, std::move(sendBuffer));
+            continue;
+        }
+
+        if (co_await AsyncSend(std::move(sendBuffer)) == false)
+            co_return;
+    }
+}
+
+/*--------------
+    LoadServer
+---------------*/
+LoadServer::LoadServer(const LoadServerOptions& options)
+    : _options(options)
+{
+    _options.threadCount = std::max(1, _options.threadCount);
+}
+
+LoadServer::~LoadServer()
+{
+    Stop();
+}
+
+bool LoadServer::Start(const NetAddress& address)
+{
+    //  忡 AsiocCore::Run  θ 尡 带 ϳ ô´
+    int32_t threadCount = _options.threadCount;
+    if (_options.shardCount > 0)
+    {
+        _core = std::make_unique<AsiocCore>(_options.shardCount, _options.shardPolicy);
+        threadCount = _core->GetShardCount();
+    }
+    else
+    {
+        _core = std::make_unique<AsiocCore>();
+    }
+
+    SessionFactory factory;
+    switch (_options.mode)
+    {
+    case LoadServerMode::Batch:
+        factory = [](asio::io_context& ioc) -> SessionRef { return std::make_shared<LoadBatchServerSession>(ioc); };
+        break;
+    case LoadServerMode::Coroutine:
+        factory = [](asio::io_context& ioc) -> SessionRef { return std::make_shared<LoadCoroutineServerSession>(ioc); };
+        break;
+    default:
+        factory = [](asio::io_context& ioc) -> SessionRef { return std::make_shared<LoadServerSession>(ioc); };
+        break;
+    }
+
+    _service = std::make_shared<ServerService>(_core->GetIoContext(), address, factory, _options.maxSessionCount);
+    _service->SetAsioCore(_core.get());
+    _service->SetCompression(_options.compression);
+    _service->SetSendFlushPolicy(_options.flushMode, _options.flushWindowUs);
+
+    if (_service->Start() == false)
+    {
+        _service = nullptr;
+        _core = nullptr;
+        return false;
+    }
+
+    _result = LoadServerResult();
+    _startTime = std::chrono::steady_clock::now();
+
+    for (int32_t i = 0; i < threadCount; i++)
+    {
+        _threads.push_back(std::thread([this]()
+            {
+                ThreadManager::InitTLS();
+
+                //  μ LoadGenerator   ʰ  尡   
+                const MetricsSnapshot start = Metrics::ThreadSnapshot();
+                _core->Run();
+                const MetricsSnapshot end = Metrics::ThreadSnapshot();
+
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _result.packets += end.Get(MetricCounter::RecvPackets) - start.Get(MetricCounter::RecvPackets);
+                    _result.sendCalls += end.Get(MetricCounter::SendCalls) - start.Get(MetricCounter::SendCalls);
+                    _result.recvCalls += end.Get(MetricCounter::RecvCalls) - start.Get(MetricCounter::RecvCalls);
+                }
+
+                ThreadManager::DestroyTLS();
+            }));
+    }
+
+    return true;
+}
+
+void LoadServer::Stop()
+{
+    if (_service == nullptr)
+        return;
+
+    _service->CloseService();
+    _core->Stop();
+    for (std::thread& t : _threads)
+        t.join();
+
+    _result.elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - _startTime).count();
+
+    _threads.clear();
+    _service = nullptr;
+    _core = nullptr;
+}
+
+LoadServerResult LoadServer::GetResult() const
+{
+    LoadServerResult result = _result;
+    result.mode = _options.mode;
+    result.flushMode = _options.flushMode;
+    result.flushWindowUs = _options.flushWindowUs;
+    return result;
+}
+
+/*--------------
+    LoadResult
+---------------*/
+std::string LoadResult::ToJson() const
+{
+    const double elapsed = elapsedSec > 0.0 ? elapsedSec : 1.0;
+
+    // 鿣 帶 ̹Ƿ epoll  io_uring       ְ 
+    char json[640];
+    ::snprintf(json, sizeof(json),
+        "{\"scenario\":\"%s\",\"io_backend\":\"%s\",\"connections\":%d,\"connected\":%d,\"threads\":%d,\"packet_size\":%d,"
+        "\"pipeline_depth\":%d,\"elapsed_sec\":%.3f,\"packets\":%llu,\"packets_per_sec\":%.1f,"
+        "\"bytes\":%llu,\"mbytes_per_sec\":%.3f,\"connects\":%llu,\"connects_per_sec\":%.1f,",
+        ToString(options.scenario), AsiocCore::GetIoBackendName(), options.connectionCount, connectedCount, options.threadCount, options.packetSize,
+        options.pipelineDepth, elapsedSec,
+        static_cast<unsigned long long>(packets), packets / elapsed,
+        static_cast<unsigned long long>(bytes), bytes / elapsed / (1024.0 * 1024.0),
+        static_cast<unsigned long long>(connects), connects / elapsed);
+
+    char compression[256];
+    ::snprintf(compression, sizeof(compression),
+        "\"compression\":\"%s\",\"compress_input_bytes\":%llu,\"compress_output_bytes\":%llu,"
+        "\"compress_ratio\":%.3f,\"compress_ms\":%.3f,\"decompress_ms\":%.3f,",
+        ToString(options.compression.codec),
+        static_cast<unsigned long long>(compressInputBytes), static_cast<unsigned long long>(compressOutputBytes),
+        compressInputBytes ? static_cast<double>(compressOutputBytes) / compressInputBytes : 1.0,
+        compressNs / 1e6, decompressNs / 1e6);
+
+    //     ð   Ŷ  
+    const double serverElapsed = server.elapsedSec > 0.0 ? server.elapsedSec : 1.0;
+    const double serverPackets = server.packets > 0 ? static_cast<double>(server.packets) : 1.0;
+
+    char serverJson[512];
+    ::snprintf(serverJson, sizeof(serverJson),
+        "\"server\":{\"mode\":\"%s\",\"flush\":\"%s\",\"flush_window_us\":%d,\"elapsed_sec\":%.3f,"
+        "\"packets\":%llu,\"send_calls\":%llu,\"send_calls_per_sec\":%.1f,\"send_calls_per_packet\":%.4f,"
+        "\"recv_calls\":%llu,\"recv_calls_per_sec\":%.1f,\"recv_calls_per_packet\":%.4f},",
+        ToString(server.mode), ToString(server.flushMode), server.flushWindowUs, server.elapsedSec,
+        static_cast<unsigned long long>(server.packets),
+        static_cast<unsigned long long>(server.sendCalls), server.sendCalls / serverElapsed, server.sendCalls / serverPackets,
+        static_cast<unsigned long long>(server.recvCalls), server.recvCalls / serverElapsed, server.recvCalls / serverPackets);
+
+    return std::string(json) + compression + serverJson
+        + "\"latency_us\":" + latency.ToJson(0.001)
+        + ",\"connect_latency_us\":" + connectLatency.ToJson(0.001) + "}";
+}
+
+/*-----------------
+    LoadGenerator
+------------------*/
+LoadGenerator::LoadGenerator(const LoadOptions& options)
+    : _options(options)
+{
+    _options.packetSize = std::clamp<int32_t>(_options.packetSize, MIN_LOAD_PACKET_SIZE, 0xFFFF);
+    _options.connectionCount = std::max(1, _options.connectionCount);
+    _options.pipelineDepth = std::max(1, _options.pipelineDepth);
+    _options.threadCount = std::max(1, _options.threadCount);
+
+    for (int32_t i = 0; i < _options.threadCount; i++)
+        _stats.push_back(std::make_unique<ThreadStats>());
+
+    _payload.resize(_options.packetSize - MIN_LOAD_PACKET_SIZE);
+    FillPayload(_payload.data(), static_cast<int32_t>(_payload.size()));
+}
+
+LoadGenerator::~LoadGenerator()
+{
+}
+
+LoadResult LoadGenerator::Run(const NetAddress& target)
+{
+    LoadResult result;
+    result.options = _options;
+
+    AsiocCore core(_options.threadCount, ShardPolicy::RoundRobin, false);
+    auto service = std::make_shared<ClientService>(core.GetIoContext(), target,
+        [this](asio::io_context& ioc) { return CreateSession(ioc); }, _options.connectionCount);
+    service->SetAsioCore(&core);
+    service->SetCompression(_options.compression);
+
+    _running.store(true);
+    _hasBroadcaster.store(false);
+
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < _options.threadCount; i++)
+    {
+        threads.push_back(std::thread([this, &core, i]()
+            {
+                ThreadManager::InitTLS();
+                LLoadStats = _stats[i].get();
+                core.Run();
+                LLoadStats = nullptr;
+                ThreadManager::DestroyTLS();
+            }));
+    }
+
+    const MetricsSnapshot metricsStart = Metrics::Snapshot();
+    const auto start = std::chrono::steady_clock::now();
+    if (service->Start())
+        std::this_thread::sleep_for(std::chrono::milliseconds(_options.durationMs));
+
+    _running.store(false);
+    result.elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.connectedCount = service->GetCurrentSessionCount();
+
+    const MetricsSnapshot metricsEnd = Metrics::Snapshot();
+    result.compressInputBytes = metricsEnd.Get(MetricCounter::CompressInputBytes) - metricsStart.Get(MetricCounter::CompressInputBytes);
+    result.compressOutputBytes = metricsEnd.Get(MetricCounter::CompressOutputBytes) - metricsStart.Get(MetricCounter::CompressOutputBytes);
+    result.compressNs = metricsEnd.Get(MetricCounter::CompressNs) - metricsStart.Get(MetricCounter::CompressNs);
+    result.decompressNs = metricsEnd.Get(MetricCounter::DecompressNs) - metricsStart.Get(MetricCounter::DecompressNs);
+
+    //       I/O 带 
+    std::vector<std::weak_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        sessions.swap(_sessions);
+    }
+
+    for (const std::weak_ptr<Session>& weak : sessions)
+    {
+        if (SessionRef session = weak.lock())
+            session->Disconnect("Load End");
+    }
+
+    core.Stop();
+    for (std::thread& t : threads)
+        t.join();
+
+    service->CloseService();
+
+    for (const std::unique_ptr<ThreadStats>& stats : _stats)
+    {
+        result.latency.Merge(stats->latency);
+        result.connectLatency.Merge(stats->connectLatency);
+        result.packets += stats->packets;
+        result.bytes += stats->bytes;
+        result.connects += stats->connects;
+
+        *stats = ThreadStats();
+    }
+
+    return result;
+}
+
+uint64_t LoadGenerator::NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LoadGenerator::ThreadStats* LoadGenerator::LocalStats()
+{
+    return static_cast<ThreadStats*>(LLoadStats);
+}
+
+std::shared_ptr<SendBuffer> LoadGenerator::MakePacket(uint16_t id)
+{
+    const uint16_t size = static_cast<uint16_t>(_options.packetSize);
+    std::shared_ptr<SendBuffer> sendBuffer = GSendBufferManager->Open(size);
+
+    PacketHeader header{ size, id };
+    ::memcpy(sendBuffer->Buffer(), &header, sizeof(header));
+    ::memcpy(sendBuffer->Buffer() + MIN_LOAD_PACKET_SIZE, _payload.data(), size - MIN_LOAD_PACKET_SIZE);
+    sendBuffer->Close(size);
+    return sendBuffer;
+}
+
+SessionRef LoadGenerator::CreateSession(asio::io_context& ioc)
+{
+    SessionRef session = std::make_shared<LoadClientSession>(ioc, this);
+
+    std::lock_guard<std::mutex> lock(_lock);
+
+    // Churn     ̹Ƿ  Ѵ
+    if (_sessions.size() >= static_cast<size_t>(_options.connectionCount) * 2)
+        std::erase_if(_sessions, [](const std::weak_ptr<Session>& weak) { return weak.expired(); });
+
+    _sessions.push_back(session);
+    return session;
+}
+
+void LoadGenerator::Reconnect(std::shared_ptr<Service> service)
+{
+    if (service == nullptr || _running.load() == false)
+        return;
+
+    service->CreateSession()->Connect();
+}
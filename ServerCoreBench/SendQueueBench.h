@@ -0,0 +1,187 @@
+#pragma once
+
+struct SendQueueBenchOptions
+{
+    int32_t     producerCount = 0;      // 0 ϸ ھ ŭ
+    int32_t     messageCount = 1000000; //  ϳ ִ  
+};
+
+struct SendQueueBenchResult
+{
+    SendQueueBenchOptions   options;
+    uint64_t                messages = 0;
+    double                  sendQueueSec = 0.0;     // Session  lock-free SendQueue
+    double                  mutexSec = 0.0;         //  Session ó ؽ + std::queue
+
+    std::string ToJson() const;
+};
+
+/*------------------
+    SendQueueBench
+-------------------*/
+//  尡  ǿ Send ϴ Ȳ ۽ ť  
+// Һ  ϳ RegisterSend ó MAX_BATCH  , ڴ  SendBuffer   ִ´
+// ex) std::cout << SendQueueBench::Run(options).ToJson();
+class SendQueueBench
+{
+    enum { MAX_BATCH = 64 };   // Session::MAX_SEND_IOV
+
+public:
+    static SendQueueBenchResult Run(const SendQueueBenchOptions& options);
+
+private:
+    static double RunSendQueue(int32_t producerCount, int32_t messageCount);
+    static double RunMutexQueue(int32_t producerCount, int32_t messageCount);
+};
+
+================================================================================
+// SendQueueBench.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "SendQueueBench.h"
+#include "SendBuffer.h"
+#include <cstdio>
+
+namespace
+{
+    enum { BENCH_BUFFER_SIZE = 64 };
+
+    std::shared_ptr<SendBuffer> MakeBuffer()
+    {
+        std::shared_ptr<SendBuffer> sendBuffer = GSendBufferManager->Open(BENCH_BUFFER_SIZE);
+        ::memset(sendBuffer->Buffer(), 0, BENCH_BUFFER_SIZE);
+        sendBuffer->Close(BENCH_BUFFER_SIZE);
+        return sendBuffer;
+    }
+
+    // ڸ    Ѳ ߽Ű, consume  total    
+    template<typename ProduceFunc, typename ConsumeFunc>
+    double RunProducers(int32_t producerCount, uint64_t total, ProduceFunc produce, ConsumeFunc consume)
+    {
+        std::atomic<bool> go = false;
+        std::vector<std::thread> producers;
+        for (int32_t i = 0; i < producerCount; i++)
+        {
+            producers.push_back(std::thread([&go, &produce]()
+                {
+                    while (go.load(std::memory_order_acquire) == false)
+                        std::this_thread::yield();
+                    produce();
+                }));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+
+        uint64_t consumed = 0;
+        while (consumed < total)
+        {
+            const int32_t popped = consume();
+            if (popped == 0)
+                std::this_thread::yield();
+            consumed += popped;
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (std::thread& t : producers)
+            t.join();
+        return elapsed;
+    }
+}
+
+SendQueueBenchResult SendQueueBench::Run(const SendQueueBenchOptions& options)
+{
+    SendQueueBenchResult result;
+    result.options = options;
+    result.options.messageCount = std::max(1, options.messageCount);
+    if (result.options.producerCount <= 0)
+        result.options.producerCount = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+    result.messages = static_cast<uint64_t>(result.options.producerCount) * result.options.messageCount;
+    result.sendQueueSec = RunSendQueue(result.options.producerCount, result.options.messageCount);
+    result.mutexSec = RunMutexQueue(result.options.producerCount, result.options.messageCount);
+    return result;
+}
+
+double SendQueueBench::RunSendQueue(int32_t producerCount, int32_t messageCount)
+{
+    const std::shared_ptr<SendBuffer> sendBuffer = MakeBuffer();
+    SendQueue queue;
+
+    // Һڰ   Ƿ Push  ۽  ȯ  ʴ´
+    auto produce = [&queue, &sendBuffer, messageCount]()
+        {
+            for (int32_t i = 0; i < messageCount; i++)
+                queue.Push(sendBuffer);
+        };
+
+    std::array<std::shared_ptr<SendBuffer>, MAX_BATCH> batch;
+    auto consume = [&queue, &batch]()
+        {
+            int32_t popped = 0;
+            while (popped < MAX_BATCH)
+            {
+                std::shared_ptr<SendBuffer> buffer = queue.Pop();
+                if (buffer == nullptr)
+                    break;
+                batch[popped++] = std::move(buffer);
+            }
+
+            if (popped > 0)
+                queue.Release(popped);
+            for (int32_t i = 0; i < popped; i++)
+                batch[i].reset();
+            return popped;
+        };
+
+    return RunProducers(producerCount, static_cast<uint64_t>(producerCount) * messageCount, produce, consume);
+}
+
+double SendQueueBench::RunMutexQueue(int32_t producerCount, int32_t messageCount)
+{
+    const std::shared_ptr<SendBuffer> sendBuffer = MakeBuffer();
+    std::mutex lock;
+    std::queue<std::shared_ptr<SendBuffer>> queue;
+
+    auto produce = [&lock, &queue, &sendBuffer, messageCount]()
+        {
+            for (int32_t i = 0; i < messageCount; i++)
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                queue.push(sendBuffer);
+            }
+        };
+
+    std::array<std::shared_ptr<SendBuffer>, MAX_BATCH> batch;
+    auto consume = [&lock, &queue, &batch]()
+        {
+            int32_t popped = 0;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                while (popped < MAX_BATCH && queue.empty() == false)
+                {
+                    batch[popped++] = std::move(queue.front());
+                    queue.pop();
+                }
+            }
+
+            for (int32_t i = 0; i < popped; i++)
+                batch[i].reset();
+            return popped;
+        };
+
+    return RunProducers(producerCount, static_cast<uint64_t>(producerCount) * messageCount, produce, consume);
+}
+
+std::string SendQueueBenchResult::ToJson() const
+{
+    char json[256];
+    ::snprintf(json, sizeof(json),
+        "{\"scenario\":\"sendqueue\",\"producers\":%d,\"messages\":%llu,"
+        "\"sendqueue_sec\":%.3f,\"sendqueue_msgs_per_sec\":%.1f,\"mutex_sec\":%.3f,\"mutex_msgs_per_sec\":%.1f}",
+        options.producerCount, static_cast<unsigned long long>(messages),
+        sendQueueSec, sendQueueSec > 0.0 ? messages / sendQueueSec : 0.0,
+        mutexSec, mutexSec > 0.0 ? messages / mutexSec : 0.0);
+    return json;
+}
@@ -0,0 +1,138 @@
+#include "pch.h"
+#include "TaskBench.h"
+#include "ThreadManager.h"
+#include <cstdio>
+
+namespace
+{
+    using Task = std::function<void()>;
+    using PostFunc = std::function<void(Task)>;
+
+    void ForkJoin(const PostFunc& post, std::atomic<uint64_t>& done, int32_t depth)
+    {
+        if (depth > 0)
+        {
+            post([&post, &done, depth]() { ForkJoin(post, done, depth - 1); });
+            post([&post, &done, depth]() { ForkJoin(post, done, depth - 1); });
+        }
+        done.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void WaitDone(const std::atomic<uint64_t>& done, uint64_t tasks)
+    {
+        while (done.load(std::memory_order_relaxed) < tasks)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    //   :  尡 ؽ ϳ Ű ť  ִ´
+    class MutexTaskQueue
+    {
+    public:
+        void Push(Task task)
+        {
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                _tasks.push_back(std::move(task));
+            }
+            _condVar.notify_one();
+        }
+
+        bool Pop(Task& task)
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _condVar.wait(guard, [this]() { return _tasks.empty() == false || _stopped; });
+            if (_tasks.empty())
+                return false;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+            return true;
+        }
+
+        void Stop()
+        {
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                _stopped = true;
+            }
+            _condVar.notify_all();
+        }
+
+    private:
+        std::mutex              _lock;
+        std::condition_variable _condVar;
+        std::deque<Task>        _tasks;
+        bool                    _stopped = false;
+    };
+}
+
+TaskBenchResult TaskBench::Run(const TaskBenchOptions& options)
+{
+    TaskBenchResult result;
+    result.options = options;
+    result.options.depth = std::clamp(options.depth, 1, 30);
+    if (result.options.workerCount <= 0)
+        result.options.workerCount = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+    result.tasks = (1ull << (result.options.depth + 1)) - 1;
+    result.poolSec = RunPool(result.options.workerCount, result.options.depth, result.tasks);
+    result.mutexSec = RunMutexQueue(result.options.workerCount, result.options.depth, result.tasks);
+    return result;
+}
+
+double TaskBench::RunPool(int32_t workerCount, int32_t depth, uint64_t tasks)
+{
+    std::atomic<uint64_t> done = 0;
+    const PostFunc post = [](Task task) { GThreadManager->Post(std::move(task)); };
+
+    GThreadManager->StartWorkers(workerCount);
+    const auto start = std::chrono::steady_clock::now();
+
+    post([&post, &done, depth]() { ForkJoin(post, done, depth); });
+    WaitDone(done, tasks);
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    GThreadManager->StopWorkers();
+    return elapsed;
+}
+
+double TaskBench::RunMutexQueue(int32_t workerCount, int32_t depth, uint64_t tasks)
+{
+    std::atomic<uint64_t> done = 0;
+    MutexTaskQueue queue;
+    const PostFunc post = [&queue](Task task) { queue.Push(std::move(task)); };
+
+    std::vector<std::thread> threads;
+    for (int32_t i = 0; i < workerCount; i++)
+    {
+        threads.push_back(std::thread([&queue]()
+            {
+                Task task;
+                while (queue.Pop(task))
+                    task();
+            }));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    post([&post, &done, depth]() { ForkJoin(post, done, depth); });
+    WaitDone(done, tasks);
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    queue.Stop();
+    for (std::thread& t : threads)
+        t.join();
+    return elapsed;
+}
+
+std::string TaskBenchResult::ToJson() const
+{
+    char json[256];
+    ::snprintf(json, sizeof(json),
+        "{\"scenario\":\"forkjoin\",\"workers\":%d,\"depth\":%d,\"tasks\":%llu,"
+        "\"pool_sec\":%.3f,\"pool_tasks_per_sec\":%.1f,\"mutex_sec\":%.3f,\"mutex_tasks_per_sec\":%.1f}",
+        options.workerCount, options.depth, static_cast<unsigned long long>(tasks),
+        poolSec, poolSec > 0.0 ? tasks / poolSec : 0.0,
+        mutexSec, mutexSec > 0.0 ? tasks / mutexSec : 0.0);
+    return json;
+}
@@ -0,0 +1,130 @@
+#include "pch.h"
+#include "TimerBench.h"
+#include "TimerWheel.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    double ElapsedSec(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+TimerBenchResult TimerBench::Run(const TimerBenchOptions& options)
+{
+    TimerBenchResult result;
+    result.options = options;
+    result.options.timerCount = std::max(1, options.timerCount);
+
+    const std::chrono::milliseconds delay(std::max(1, options.delayMs));
+    if (result.options.wheel)
+        result.wheel = RunWheel(result.options.timerCount, delay);
+    if (result.options.steadyTimer)
+        result.steadyTimer = RunSteadyTimer(result.options.timerCount, delay);
+    return result;
+}
+
+TimerBenchResult::Side TimerBench::RunWheel(int32_t timerCount, std::chrono::milliseconds delay)
+{
+    TimerBenchResult::Side side;
+    asio::io_context ioc;
+    TimerWheel& wheel = TimerWheel::Get(ioc);
+    uint64_t fired = 0;
+
+    std::vector<TimerId> timers;
+    timers.reserve(timerCount);
+
+    const int64_t rssBefore = ResidentBytes();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int32_t i = 0; i < timerCount; i++)
+        timers.push_back(wheel.Schedule(delay, [&fired]() { fired++; }));
+
+    side.scheduleSec = ElapsedSec(start);
+    side.rssBytes = ResidentBytes() - rssBefore;
+    start = std::chrono::steady_clock::now();
+
+    for (TimerId timerId : timers)
+        wheel.Cancel(timerId);
+
+    side.cancelSec = ElapsedSec(start);
+    return side;
+}
+
+TimerBenchResult::Side TimerBench::RunSteadyTimer(int32_t timerCount, std::chrono::milliseconds delay)
+{
+    TimerBenchResult::Side side;
+    asio::io_context ioc;
+    uint64_t fired = 0;
+
+    std::vector<std::unique_ptr<asio::steady_timer>> timers;
+    timers.reserve(timerCount);
+
+    const int64_t rssBefore = ResidentBytes();
+    auto start = std::chrono::steady_clock::now();
+
+    for (int32_t i = 0; i < timerCount; i++)
+    {
+        auto timer = std::make_unique<asio::steady_timer>(ioc, delay);
+        timer->async_wait([&fired](const std::error_code& error)
+            {
+                if (!error)
+                    fired++;
+            });
+        timers.push_back(std::move(timer));
+    }
+
+    side.scheduleSec = ElapsedSec(start);
+    side.rssBytes = ResidentBytes() - rssBefore;
+    start = std::chrono::steady_clock::now();
+
+    for (const std::unique_ptr<asio::steady_timer>& timer : timers)
+        timer->cancel();
+
+    // ҵ ڵ鷯 operation_aborted  ҷ ۾ ° Ǯ
+    ioc.run();
+
+    side.cancelSec = ElapsedSec(start);
+    return side;
+}
+
+int64_t TimerBench::ResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (::GetProcessMemoryInfo(::GetCurrentProcess(), &counters, sizeof(counters)) == FALSE)
+        return 0;
+    return static_cast<int64_t>(counters.WorkingSetSize);
+#else
+    // statm   °    
+    FILE* file = ::fopen("/proc/self/statm", "r");
+    if (file == nullptr)
+        return 0;
+
+    long long totalPages = 0;
+    long long residentPages = 0;
+    const int matched = ::fscanf(file, "%lld %lld", &totalPages, &residentPages);
+    ::fclose(file);
+    return matched == 2 ? residentPages * ::sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+std::string TimerBenchResult::ToJson() const
+{
+    char json[512];
+    ::snprintf(json, sizeof(json),
+        "{\"scenario\":\"timers\",\"timers\":%d,\"delay_ms\":%d,"
+        "\"wheel_schedule_sec\":%.4f,\"wheel_cancel_sec\":%.4f,\"wheel_rss_bytes\":%lld,"
+        "\"asio_schedule_sec\":%.4f,\"asio_cancel_sec\":%.4f,\"asio_rss_bytes\":%lld}",
+        options.timerCount, options.delayMs,
+        wheel.scheduleSec, wheel.cancelSec, static_cast<long long>(wheel.rssBytes),
+        steadyTimer.scheduleSec, steadyTimer.cancelSec, static_cast<long long>(steadyTimer.rssBytes));
+    return json;
+}
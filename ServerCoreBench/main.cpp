@@ -0,0 +1,209 @@
+#include "pch.h"
+#include "LoadGenerator.h"
+#include "TaskBench.h"
+#include "TimerBench.h"
+#include "SendQueueBench.h"
+#include "NetAddress.h"
+#include <cstring>
+
+//  μ LoadServer   LoadGenerator  ϸ    JSON  ٷ 
+// ex) ServerCoreBench --scenario echo --connections 100 --packet-size 64 --threads 2 --duration-ms 5000
+//   /   񱳴 --server-threads N  --server-shards N   Ϸ   
+// ex) ServerCoreBench --scenario pingpong --connections 10000 --server-shards 8
+// Ŷ óϴ ο ġ  񱳴 --server callback  --server batch   Ϸ   
+// ex) ServerCoreBench --scenario echo --packet-size 16 --pipeline 64 --server batch
+// ۽ flush å 񱳴 --flush  ٲ  server.send_calls_per_sec  latency_us.p99  
+// ex) ServerCoreBench --scenario echo --connections 1000 --flush window --flush-window-us 200
+// epoll / io_uring 񱳴 SERVERCORE_IO_URING     带  Ϸ 
+// io_backend  server.send_calls_per_packet / recv_calls_per_packet  
+// forkjoin  Ʈũ  ThreadManager ۾ Ǯ ؽ  ť Ѵ
+// ex) ServerCoreBench --scenario forkjoin --threads 8 --depth 20
+// timers  TimerWheel  asio::steady_timer  Ÿ̸Ӹ ɰ ϴ ð ޸𸮸 Ѵ
+// ex) ServerCoreBench --scenario timers --timers 100000
+// sendqueue   ڰ  ǿ Send   lock-free SendQueue  ؽ ť Ѵ
+// ex) ServerCoreBench --scenario sendqueue --threads 8 --messages 1000000
+namespace
+{
+    //   μ ȿ  ó
+    enum class LocalBench
+    {
+        None,
+        ForkJoin,
+        Timers,
+        SendQueue,
+    };
+
+    bool ParseLocalBench(const char* name, LocalBench& bench)
+    {
+        if (::strcmp(name, "forkjoin") == 0)        bench = LocalBench::ForkJoin;
+        else if (::strcmp(name, "timers") == 0)     bench = LocalBench::Timers;
+        else if (::strcmp(name, "sendqueue") == 0)  bench = LocalBench::SendQueue;
+        else return false;
+        return true;
+    }
+
+    bool ParseScenario(const char* name, LoadScenario& scenario)
+    {
+        if (::strcmp(name, "echo") == 0)            scenario = LoadScenario::Echo;
+        else if (::strcmp(name, "pingpong") == 0)   scenario = LoadScenario::PingPong;
+        else if (::strcmp(name, "broadcast") == 0)  scenario = LoadScenario::Broadcast;
+        else if (::strcmp(name, "churn") == 0)      scenario = LoadScenario::Churn;
+        else return false;
+        return true;
+    }
+
+    bool ParseCodec(const char* name, CompressionCodec& codec)
+    {
+        if (::strcmp(name, "none") == 0)            codec = CompressionCodec::None;
+        else if (::strcmp(name, "lz4") == 0)        codec = CompressionCodec::Lz4;
+        else if (::strcmp(name, "zstd") == 0)       codec = CompressionCodec::Zstd;
+        else return false;
+        return true;
+    }
+
+    bool ParseServerMode(const char* name, LoadServerMode& mode)
+    {
+        if (::strcmp(name, "callback") == 0)        mode = LoadServerMode::Callback;
+        else if (::strcmp(name, "batch") == 0)      mode = LoadServerMode::Batch;
+        else if (::strcmp(name, "coroutine") == 0)  mode = LoadServerMode::Coroutine;
+        else return false;
+        return true;
+    }
+
+    bool ParseFlushMode(const char* name, SendFlushMode& mode)
+    {
+        if (::strcmp(name, "immediate") == 0)           mode = SendFlushMode::Immediate;
+        else if (::strcmp(name, "endofhandler") == 0)   mode = SendFlushMode::EndOfHandler;
+        else if (::strcmp(name, "window") == 0)         mode = SendFlushMode::Window;
+        else return false;
+        return true;
+    }
+
+    bool ParseShardPolicy(const char* name, ShardPolicy& policy)
+    {
+        if (::strcmp(name, "roundrobin") == 0)        policy = ShardPolicy::RoundRobin;
+        else if (::strcmp(name, "leastloaded") == 0)  policy = ShardPolicy::LeastLoaded;
+        else return false;
+        return true;
+    }
+
+    bool ParseTimerImpl(const char* name, TimerBenchOptions& options)
+    {
+        if (::strcmp(name, "both") == 0)            options.wheel = options.steadyTimer = true;
+        else if (::strcmp(name, "wheel") == 0)      { options.wheel = true; options.steadyTimer = false; }
+        else if (::strcmp(name, "steady") == 0)     { options.wheel = false; options.steadyTimer = true; }
+        else return false;
+        return true;
+    }
+
+    void PrintUsage()
+    {
+        std::cerr <<
+            "usage: ServerCoreBench [options]\n"
+            "  --scenario echo|pingpong|broadcast|churn|forkjoin|timers|sendqueue (echo)\n"
+            "  --connections N                            (100)\n"
+            "  --packet-size BYTES                        (64,  , ּ 16)\n"
+            "  --pipeline N                               (8, echo     Ŷ )\n"
+            "  --threads N                                (2, Ŭ̾Ʈ I/O . forkjoin  Ŀ , sendqueue   , 0 ̸ ھ )\n"
+            "  --depth N                                  (20, forkjoin  . ۾ 2^(N+1) - 1 )\n"
+            "  --timers N                                 (100000, timers  ɰ  Ÿ̸ )\n"
+            "  --timer-impl both|wheel|steady             (both, ʸ  RSS   ʴ´)\n"
+            "  --messages N                               (1000000, sendqueue   ϳ ִ  )\n"
+            "  --server-threads N                         (2)\n"
+            "  --server-shards N                          (0, 0 ̸  io_context. N ̸   帶  ϳ)\n"
+            "  --shard-policy roundrobin|leastloaded      (roundrobin,  忡  )\n"
+            "  --server callback|batch|coroutine          (callback,   . batch  OnRecvPackets  ޴´)\n"
+            "  --flush immediate|endofhandler|window      (immediate,   ۽ flush å)\n"
+            "  --flush-window-us US                       (0, --flush window    ð)\n"
+            "  --duration-ms MS                           (5000)\n"
+            "  --compression none|lz4|zstd                (none,   )\n"
+            "  --port PORT                                (7777)\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CoreGlobal coreGlobal;
+
+    LoadOptions options;
+    LoadServerOptions serverOptions;
+    TaskBenchOptions taskOptions;
+    TimerBenchOptions timerOptions;
+    SendQueueBenchOptions sendQueueOptions;
+    LocalBench localBench = LocalBench::None;
+    uint16_t port = 7777;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        const char* key = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr)
+        {
+            PrintUsage();
+            return 1;
+        }
+
+        bool valid = true;
+        if (::strcmp(key, "--scenario") == 0)               valid = ParseLocalBench(value, localBench) || ParseScenario(value, options.scenario);
+        else if (::strcmp(key, "--connections") == 0)       options.connectionCount = std::atoi(value);
+        else if (::strcmp(key, "--packet-size") == 0)       options.packetSize = std::atoi(value);
+        else if (::strcmp(key, "--pipeline") == 0)          options.pipelineDepth = std::atoi(value);
+        else if (::strcmp(key, "--threads") == 0)           options.threadCount = taskOptions.workerCount = sendQueueOptions.producerCount = std::atoi(value);
+        else if (::strcmp(key, "--depth") == 0)             taskOptions.depth = std::atoi(value);
+        else if (::strcmp(key, "--timers") == 0)            timerOptions.timerCount = std::atoi(value);
+        else if (::strcmp(key, "--timer-impl") == 0)        valid = ParseTimerImpl(value, timerOptions);
+        else if (::strcmp(key, "--messages") == 0)          sendQueueOptions.messageCount = std::atoi(value);
+        else if (::strcmp(key, "--server-threads") == 0)    serverOptions.threadCount = std::atoi(value);
+        else if (::strcmp(key, "--server-shards") == 0)     serverOptions.shardCount = std::atoi(value);
+        else if (::strcmp(key, "--shard-policy") == 0)      valid = ParseShardPolicy(value, serverOptions.shardPolicy);
+        else if (::strcmp(key, "--server") == 0)            valid = ParseServerMode(value, serverOptions.mode);
+        else if (::strcmp(key, "--flush") == 0)             valid = ParseFlushMode(value, serverOptions.flushMode);
+        else if (::strcmp(key, "--flush-window-us") == 0)   serverOptions.flushWindowUs = std::atoi(value);
+        else if (::strcmp(key, "--duration-ms") == 0)       options.durationMs = std::atoi(value);
+        else if (::strcmp(key, "--compression") == 0)       valid = ParseCodec(value, options.compression.codec);
+        else if (::strcmp(key, "--port") == 0)              port = static_cast<uint16_t>(std::atoi(value));
+        else valid = false;
+
+        if (valid == false)
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (localBench == LocalBench::ForkJoin)
+    {
+        std::cout << TaskBench::Run(taskOptions).ToJson() << std::endl;
+        return 0;
+    }
+
+    if (localBench == LocalBench::Timers)
+    {
+        std::cout << TimerBench::Run(timerOptions).ToJson() << std::endl;
+        return 0;
+    }
+
+    if (localBench == LocalBench::SendQueue)
+    {
+        std::cout << SendQueueBench::Run(sendQueueOptions).ToJson() << std::endl;
+        return 0;
+    }
+
+    serverOptions.maxSessionCount = std::max(serverOptions.maxSessionCount, options.connectionCount * 2);
+    serverOptions.compression = options.compression;
+
+    const NetAddress address("127.0.0.1", port);
+    LoadServer server(serverOptions);
+    if (server.Start(address) == false)
+    {
+        std::cerr << "LoadServer start failed (port " << port << ")" << std::endl;
+        return 1;
+    }
+
+    LoadResult result = LoadGenerator(options).Run(address);
+    server.Stop();
+    result.server = server.GetResult();
+
+    std::cout << result.ToJson() << std::endl;
+    return 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "CorePch.h"
+
+================================================================================
+// pch.cpp file content
+================================================================================
+
+#include "pch.h"
\ No newline at end of file
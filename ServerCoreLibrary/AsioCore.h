@@ -6,24 +6,68 @@ public:
     virtual void OnDispatch(const std::error_code& ec, size_t bytesTransferred) = 0;
 };
 
+enum class IoBackend : uint8_t
+{
+    Iocp,
+    Epoll,
+    IoUring,
+    Other
+};
 
+enum class ShardPolicy : uint8_t
+{
+    RoundRobin,
+    LeastLoaded
+};
+
+/*----------------
+    AsiocCore
+-----------------*/
+//   : io_context ϳ  I/O 尡  
+//   : 帶 io_context ϳ (CPU ),   忡 
 class AsiocCore
 {
 public:
-    AsiocCore()
-        : _ioc()
-    {
-    }
+    AsiocCore();
+    AsiocCore(int32_t shardCount, ShardPolicy policy = ShardPolicy::RoundRobin, bool pinThreads = true);
+    ~AsiocCore();
 
-    ~AsiocCore() = default;
+    asio::io_context& GetIoContext() { return _shards[0]->ioc; }
+    asio::io_context& GetIoContext(int32_t index) { return _shards[index]->ioc; }
+    asio::io_context& NextIoContext();
 
-    asio::io_context& GetIoContext() { return _ioc; }
-    void Stop() { _ioc.stop(); }
-    void Reset() { _ioc.restart(); }
-    void Run() { _ioc.run(); }
+    //    I/O 鿣 (  α׿)
+    static IoBackend    GetIoBackend();
+    static const char*  GetIoBackendName();
+
+    bool    IsSharded() const { return _sharded; }
+    int32_t GetShardCount() const { return static_cast<int32_t>(_shards.size()); }
+    int32_t GetShardLoad(int32_t index) const { return _shards[index]->load.load(std::memory_order_relaxed); }
+    void    AddLoad(asio::io_context& ioc, int32_t delta);
+
+    void Stop();
+    void Reset();
+    void Run();
 
 private:
-    asio::io_context _ioc;
+    using WorkGuard = asio::executor_work_guard<asio::io_context::executor_type>;
+
+    struct alignas(64) Shard
+    {
+        Shard() = default;
+        Shard(int32_t concurrencyHint) : ioc(concurrencyHint) {}
+
+        asio::io_context            ioc;
+        std::atomic<int32_t>        load = 0;   //   
+        std::unique_ptr<WorkGuard>  work;
+    };
+
+    bool                                _sharded = false;
+    bool                                _pinThreads = false;
+    ShardPolicy                         _policy = ShardPolicy::RoundRobin;
+    std::vector<std::unique_ptr<Shard>> _shards;
+    std::atomic<uint32_t>               _nextShard = 0;
+    std::atomic<int32_t>                _runIndex = 0;
 };
 
 ================================================================================
@@ -32,3 +76,124 @@ private:
 
 #include "pch.h"
 #include "AsioCore.h"
+#include "ThreadManager.h"
+
+AsiocCore::AsiocCore()
+{
+    _shards.push_back(std::make_unique<Shard>());
+}
+
+AsiocCore::AsiocCore(int32_t shardCount, ShardPolicy policy, bool pinThreads)
+    : _sharded(true)
+    , _pinThreads(pinThreads)
+    , _policy(policy)
+{
+    if (shardCount <= 0)
+        shardCount = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int32_t i = 0; i < shardCount; i++)
+    {
+        //  ϳ  ϳ Ƿ   ̵ Ʈ ش
+        auto shard = std::make_unique<Shard>(1);
+        //  Ǳ  run()   ʵ 
+        shard->work = std::make_unique<WorkGuard>(shard->ioc.get_executor());
+        _shards.push_back(std::move(shard));
+    }
+}
+
+AsiocCore::~AsiocCore()
+{
+    Stop();
+}
+
+IoBackend AsiocCore::GetIoBackend()
+{
+#if defined(ASIO_HAS_IOCP)
+    return IoBackend::Iocp;
+#elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    return IoBackend::IoUring;
+#elif defined(ASIO_HAS_EPOLL)
+    return IoBackend::Epoll;
+#else
+    return IoBackend::Other;
+#endif
+}
+
+const char* AsiocCore::GetIoBackendName()
+{
+    switch (GetIoBackend())
+    {
+    case IoBackend::Iocp:       return "iocp";
+    case IoBackend::Epoll:      return "epoll";
+    case IoBackend::IoUring:    return "io_uring";
+    default:                    return "other";
+    }
+}
+
+asio::io_context& AsiocCore::NextIoContext()
+{
+    if (_shards.size() == 1)
+        return _shards[0]->ioc;
+
+    if (_policy == ShardPolicy::LeastLoaded)
+    {
+        Shard* best = _shards[0].get();
+        for (const auto& shard : _shards)
+        {
+            if (shard->load.load(std::memory_order_relaxed) < best->load.load(std::memory_order_relaxed))
+                best = shard.get();
+        }
+        return best->ioc;
+    }
+
+    uint32_t index = _nextShard.fetch_add(1, std::memory_order_relaxed);
+    return _shards[index % _shards.size()]->ioc;
+}
+
+void AsiocCore::AddLoad(asio::io_context& ioc, int32_t delta)
+{
+    for (const auto& shard : _shards)
+    {
+        if (&shard->ioc == &ioc)
+        {
+            shard->load.fetch_add(delta, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void AsiocCore::Stop()
+{
+    for (const auto& shard : _shards)
+    {
+        shard->work.reset();
+        shard->ioc.stop();
+    }
+}
+
+void AsiocCore::Reset()
+{
+    for (const auto& shard : _shards)
+    {
+        shard->ioc.restart();
+        if (_sharded && shard->work == nullptr)
+            shard->work = std::make_unique<WorkGuard>(shard->ioc.get_executor());
+    }
+    _runIndex.store(0);
+}
+
+void AsiocCore::Run()
+{
+    if (_sharded == false)
+    {
+        _shards[0]->ioc.run();
+        return;
+    }
+
+    // Run  ȣ  带 ϳ ô´
+    int32_t index = _runIndex.fetch_add(1) % GetShardCount();
+    if (_pinThreads)
+        ThreadManager::SetAffinity(index % static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency())));
+
+    _shards[index]->ioc.run();
+}
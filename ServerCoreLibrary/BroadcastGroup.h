@@ -0,0 +1,190 @@
+#pragma once
+
+class Session;
+class SendBuffer;
+using SessionRef = std::shared_ptr<Session>;
+
+/*------------------
+    BroadcastGroup
+-------------------*/
+//  /  / äó     
+//  ʹ SendBuffer ϳ   , ޴ Ǹ  ϳ ø
+// ڰ  ۽ ť ֱ ȣ 忡 ϰ,    io_context()  ķ Ǵ
+//   Ǹ   (ռ θ Broadcast / Send   )
+class BroadcastGroup : public std::enable_shared_from_this<BroadcastGroup>
+{
+    enum
+    {
+        PARALLEL_THRESHOLD = 1024,  // ̺    
+        FANOUT_CHUNK_SIZE = 256,    // ۾ ϳ ô  
+    };
+
+public:
+    BroadcastGroup(uint64_t groupId) : _groupId(groupId) {}
+
+    BroadcastGroup(const BroadcastGroup&) = delete;
+    BroadcastGroup& operator=(const BroadcastGroup&) = delete;
+
+    bool    Join(SessionRef session);
+    bool    Leave(const SessionRef& session);
+    void    Broadcast(std::shared_ptr<SendBuffer> sendBuffer);
+
+    uint64_t GetGroupId() const { return _groupId; }
+    int32_t  GetMemberCount();
+
+private:
+    //  io_context   ǳ  д
+    struct Bucket
+    {
+        asio::io_context*       ioc;
+        std::vector<SessionRef> sessions;
+    };
+    using Snapshot = std::vector<Bucket>;
+
+    std::shared_ptr<const Snapshot> GetSnapshot();
+
+private:
+    uint64_t                                _groupId;
+    std::mutex                              _lock;
+    std::vector<SessionRef>                 _members;
+    std::unordered_map<Session*, uint32_t>  _memberIndex;   //  Leave (swap & pop)
+    std::shared_ptr<const Snapshot>         _snapshot;      // null ̸ ٽ 
+};
+
+using BroadcastGroupRef = std::shared_ptr<BroadcastGroup>;
+
+================================================================================
+// BroadcastGroup.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "BroadcastGroup.h"
+#include "Session.h"
+#include "SendBuffer.h"
+
+bool BroadcastGroup::Join(SessionRef session)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_memberIndex.contains(session.get()))
+            return false;
+
+        _memberIndex.emplace(session.get(), static_cast<uint32_t>(_members.size()));
+        _members.push_back(session);
+        _snapshot = nullptr;
+    }
+
+    session->AddGroup(shared_from_this());
+
+    //  ̿   LeaveAllGroups    ִ
+    if (session->IsConnected() == false)
+        Leave(session);
+
+    return true;
+}
+
+bool BroadcastGroup::Leave(const SessionRef& session)
+{
+    SessionRef removed;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto it = _memberIndex.find(session.get());
+        if (it == _memberIndex.end())
+            return false;
+
+        const uint32_t index = it->second;
+        _memberIndex.erase(it);
+
+        removed = std::move(_members[index]);
+        if (index + 1 != _members.size())
+        {
+            _members[index] = std::move(_members.back());
+            _memberIndex[_members[index].get()] = index;
+        }
+        _members.pop_back();
+        _snapshot = nullptr;
+    }
+
+    removed->RemoveGroup(this);
+    return true;
+}
+
+void BroadcastGroup::Broadcast(std::shared_ptr<SendBuffer> sendBuffer)
+{
+    std::shared_ptr<const Snapshot> snapshot = GetSnapshot();
+
+    size_t total = 0;
+    for (const Bucket& bucket : *snapshot)
+        total += bucket.sessions.size();
+
+    if (total <= PARALLEL_THRESHOLD)
+    {
+        for (const Bucket& bucket : *snapshot)
+            for (const SessionRef& session : bucket.sessions)
+                session->Send(sendBuffer);
+        return;
+    }
+
+    // ۽ ť ִ  ⼭ . ׷ Ǹ     Send /  ۺ  
+    //  ⸦ Ŵ FlushSend    io_context   
+    // (  帶 ,    I/O 尡  ô´)
+    for (const Bucket& bucket : *snapshot)
+    {
+        // ۽   Ǹ ⸦ ɾ ָ ȴ ( ̹  ִ ۽ ̾ )
+        auto owners = std::make_shared<std::vector<SessionRef>>();
+        for (const SessionRef& session : bucket.sessions)
+        {
+            if (session->EnqueueSend(sendBuffer))
+                owners->push_back(session);
+        }
+
+        for (size_t begin = 0; begin < owners->size(); begin += FANOUT_CHUNK_SIZE)
+        {
+            const size_t end = std::min<size_t>(begin + FANOUT_CHUNK_SIZE, owners->size());
+            asio::post(*bucket.ioc, [owners, begin, end]()
+                {
+                    for (size_t i = begin; i < end; i++)
+                        (*owners)[i]->FlushSend();
+                });
+        }
+    }
+}
+
+int32_t BroadcastGroup::GetMemberCount()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return static_cast<int32_t>(_members.size());
+}
+
+std::shared_ptr<const BroadcastGroup::Snapshot> BroadcastGroup::GetSnapshot()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+
+    //       ״  
+    if (_snapshot == nullptr)
+    {
+        auto snapshot = std::make_shared<Snapshot>();
+        for (const SessionRef& session : _members)
+        {
+            asio::io_context* ioc = &session->GetIoContext();
+
+            Bucket* bucket = nullptr;
+            for (Bucket& candidate : *snapshot)
+            {
+                if (candidate.ioc == ioc)
+                {
+                    bucket = &candidate;
+                    break;
+                }
+            }
+
+            if (bucket == nullptr)
+                bucket = &snapshot->emplace_back(Bucket{ ioc, {} });
+
+            bucket->sessions.push_back(session);
+        }
+        _snapshot = std::move(snapshot);
+    }
+
+    return _snapshot;
+}
@@ -0,0 +1,295 @@
+#include "pch.h"
+#include "Compression.h"
+#include "SendBuffer.h"
+#include "Session.h"
+#include "Metrics.h"
+
+#ifdef SERVERCORE_LZ4
+#include <lz4.h>
+#endif
+#ifdef SERVERCORE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace
+{
+    constexpr int32_t COMPRESSED_HEADER_SIZE = sizeof(PacketHeader) + sizeof(CompressedPacketHeader);
+
+    // 帶 ϳ.   ؽƮ  ʴ´
+    struct CompressionContext
+    {
+#ifdef SERVERCORE_LZ4
+        std::vector<char>   lz4State;           //    (LZ4_compress_fast_extState)
+        LZ4_stream_t*       lz4Stream = nullptr; //  ư 
+#endif
+#ifdef SERVERCORE_ZSTD
+        ZSTD_CCtx*          zstdCCtx = nullptr;
+        ZSTD_DCtx*          zstdDCtx = nullptr;
+#endif
+        std::vector<BYTE>   scratch;            //  Ǭ  (ִ Ŷ ũ)
+
+        ~CompressionContext()
+        {
+#ifdef SERVERCORE_LZ4
+            if (lz4Stream)
+                LZ4_freeStream(lz4Stream);
+#endif
+#ifdef SERVERCORE_ZSTD
+            ZSTD_freeCCtx(zstdCCtx);
+            ZSTD_freeDCtx(zstdDCtx);
+#endif
+        }
+    };
+
+    thread_local CompressionContext LCompressionContext;
+
+    inline uint64_t NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+/*-------------------------
+    CompressionDictionary
+--------------------------*/
+CompressionDictionary::CompressionDictionary(uint8_t id, std::vector<BYTE> data, int32_t zstdLevel)
+    : _id(id), _data(std::move(data))
+{
+    // 0   
+    assert(_id != 0);
+
+#ifdef SERVERCORE_ZSTD
+    _zstdCDict = ZSTD_createCDict(_data.data(), _data.size(), zstdLevel);
+    _zstdDDict = ZSTD_createDDict(_data.data(), _data.size());
+#endif
+}
+
+CompressionDictionary::~CompressionDictionary()
+{
+#ifdef SERVERCORE_ZSTD
+    ZSTD_freeCDict(static_cast<ZSTD_CDict*>(_zstdCDict));
+    ZSTD_freeDDict(static_cast<ZSTD_DDict*>(_zstdDDict));
+#endif
+}
+
+/*--------------------
+    PacketCompressor
+---------------------*/
+bool PacketCompressor::IsSupported(CompressionCodec codec)
+{
+    switch (codec)
+    {
+#ifdef SERVERCORE_LZ4
+    case CompressionCodec::Lz4:     return true;
+#endif
+#ifdef SERVERCORE_ZSTD
+    case CompressionCodec::Zstd:    return true;
+#endif
+    default:                        return false;
+    }
+}
+
+std::shared_ptr<SendBuffer> PacketCompressor::Compress(const std::shared_ptr<SendBuffer>& sendBuffer, const CompressionOptions& options)
+{
+    //  Ŷ  ũ uint16 ̰, ū ޽   Ƿ ǵ帮 ʴ´
+    const uint32_t writeSize = sendBuffer->WriteSize();
+    if (sendBuffer->IsCompressible() == false || writeSize < options.minSize || writeSize > 0xFFFF)
+        return sendBuffer;
+
+    PacketHeader header;
+    ::memcpy(&header, sendBuffer->Buffer(), sizeof(header));
+    assert(header.id != COMPRESSED_PACKET_ID);
+    if (header.size == 0)
+        return sendBuffer;
+
+    // ó    ΰ    װ  
+    const uint64_t key = CacheKey(options);
+    std::call_once(sendBuffer->_compressOnce, [&]()
+        {
+            sendBuffer->_compressedKey = key;
+            sendBuffer->_compressed = CompressBuffer(*sendBuffer, options);
+        });
+
+    std::shared_ptr<SendBuffer> compressed = sendBuffer->_compressedKey == key ? sendBuffer->_compressed : CompressBuffer(*sendBuffer, options);
+    return compressed ? compressed : sendBuffer;
+}
+
+std::span<BYTE> PacketCompressor::Decompress(const BYTE* packet, int32_t len, const CompressionOptions& options)
+{
+    if (len < COMPRESSED_HEADER_SIZE)
+        return {};
+
+    CompressedPacketHeader header;
+    ::memcpy(&header, packet + sizeof(PacketHeader), sizeof(header));
+
+    //  ڵ /  ٸ ߸ Ŷ
+    const uint8_t dictionaryId = options.dictionary ? options.dictionary->GetId() : 0;
+    if (header.codec != static_cast<uint8_t>(options.codec) || header.dictionaryId != dictionaryId || header.originalSize < sizeof(PacketHeader))
+        return {};
+
+    std::vector<BYTE>& scratch = LCompressionContext.scratch;
+    if (scratch.empty())
+        scratch.resize(0x10000);
+
+    const uint64_t startNs = NowNs();
+    const int32_t size = DecompressRaw(options, packet + COMPRESSED_HEADER_SIZE, len - COMPRESSED_HEADER_SIZE, scratch.data(), header.originalSize);
+    Metrics::Add(MetricCounter::DecompressNs, NowNs() - startNs);
+
+    if (size != header.originalSize)
+        return {};
+
+    // Ǯ  ϼ Ϲ Ŷ ̾ ־ Ѵ
+    for (int32_t offset = 0; offset < size; )
+    {
+        PacketHeader inner;
+        if (size - offset < sizeof(PacketHeader))
+            return {};
+
+        ::memcpy(&inner, &scratch[offset], sizeof(PacketHeader));
+        if (inner.size < sizeof(PacketHeader) || inner.size > size - offset || inner.id == COMPRESSED_PACKET_ID)
+            return {};
+
+        offset += inner.size;
+    }
+
+    return std::span<BYTE>(scratch.data(), size);
+}
+
+//  ũ, dest   ų ϸ 0
+int32_t PacketCompressor::CompressRaw(const CompressionOptions& options, const BYTE* src, int32_t srcSize, BYTE* dest, int32_t destCapacity)
+{
+    CompressionContext& context = LCompressionContext;
+    const CompressionDictionary* dictionary = options.dictionary.get();
+
+    switch (options.codec)
+    {
+#ifdef SERVERCORE_LZ4
+    case CompressionCodec::Lz4:
+    {
+        const int32_t acceleration = std::max(1, options.level);
+        if (dictionary)
+        {
+            if (context.lz4Stream == nullptr)
+                context.lz4Stream = LZ4_createStream();
+
+            std::span<const BYTE> data = dictionary->GetData();
+            LZ4_loadDict(context.lz4Stream, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()));
+            return LZ4_compress_fast_continue(context.lz4Stream, reinterpret_cast<const char*>(src),
+                reinterpret_cast<char*>(dest), srcSize, destCapacity, acceleration);
+        }
+
+        if (context.lz4State.empty())
+            context.lz4State.resize(LZ4_sizeofState());
+
+        return LZ4_compress_fast_extState(context.lz4State.data(), reinterpret_cast<const char*>(src),
+            reinterpret_cast<char*>(dest), srcSize, destCapacity, acceleration);
+    }
+#endif
+#ifdef SERVERCORE_ZSTD
+    case CompressionCodec::Zstd:
+    {
+        if (context.zstdCCtx == nullptr)
+            context.zstdCCtx = ZSTD_createCCtx();
+
+        size_t result;
+        if (dictionary && dictionary->_zstdCDict)
+            result = ZSTD_compress_usingCDict(context.zstdCCtx, dest, destCapacity, src, srcSize,
+                static_cast<const ZSTD_CDict*>(dictionary->_zstdCDict));
+        else
+            result = ZSTD_compressCCtx(context.zstdCCtx, dest, destCapacity, src, srcSize, options.level);
+
+        return ZSTD_isError(result) ? 0 : static_cast<int32_t>(result);
+    }
+#endif
+    default:
+        return 0;
+    }
+}
+
+// Ǭ ũ, ϸ -1
+int32_t PacketCompressor::DecompressRaw(const CompressionOptions& options, const BYTE* src, int32_t srcSize, BYTE* dest, int32_t destCapacity)
+{
+    CompressionContext& context = LCompressionContext;
+    const CompressionDictionary* dictionary = options.dictionary.get();
+
+    switch (options.codec)
+    {
+#ifdef SERVERCORE_LZ4
+    case CompressionCodec::Lz4:
+    {
+        if (dictionary)
+        {
+            std::span<const BYTE> data = dictionary->GetData();
+            return LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest),
+                srcSize, destCapacity, reinterpret_cast<const char*>(data.data()), static_cast<int>(data.size()));
+        }
+
+        return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dest), srcSize, destCapacity);
+    }
+#endif
+#ifdef SERVERCORE_ZSTD
+    case CompressionCodec::Zstd:
+    {
+        if (context.zstdDCtx == nullptr)
+            context.zstdDCtx = ZSTD_createDCtx();
+
+        size_t result;
+        if (dictionary && dictionary->_zstdDDict)
+            result = ZSTD_decompress_usingDDict(context.zstdDCtx, dest, destCapacity, src, srcSize,
+                static_cast<const ZSTD_DDict*>(dictionary->_zstdDDict));
+        else
+            result = ZSTD_decompressDCtx(context.zstdDCtx, dest, destCapacity, src, srcSize);
+
+        return ZSTD_isError(result) ? -1 : static_cast<int32_t>(result);
+    }
+#endif
+    default:
+        return -1;
+    }
+}
+
+uint64_t PacketCompressor::CacheKey(const CompressionOptions& options)
+{
+    //  (zstd  ) Ƿ 32Ʈ ״ ´. 0     
+    const uint64_t dictionaryId = options.dictionary ? options.dictionary->GetId() : 0;
+    return (static_cast<uint64_t>(static_cast<uint32_t>(options.level)) << 32) | (dictionaryId << 16)
+        | (static_cast<uint64_t>(options.codec) << 8) | 1;
+}
+
+std::shared_ptr<SendBuffer> PacketCompressor::CompressBuffer(SendBuffer& sendBuffer, const CompressionOptions& options)
+{
+    const int32_t originalSize = static_cast<int32_t>(sendBuffer.WriteSize());
+    if (originalSize <= COMPRESSED_HEADER_SIZE + 1)
+        return nullptr;
+
+    //  ۾ƾ ǹ̰ Ƿ    ũ ȿ ޴´
+    // Send  θ  ٸ SendBuffer    ä  Ƿ  ûũ 
+    std::shared_ptr<SendBuffer> compressed = GSendBufferManager->OpenDetached(originalSize);
+
+    const uint64_t startNs = NowNs();
+    const int32_t bodySize = CompressRaw(options, sendBuffer.Buffer(), originalSize,
+        compressed->Buffer() + COMPRESSED_HEADER_SIZE, originalSize - COMPRESSED_HEADER_SIZE - 1);
+    Metrics::Add(MetricCounter::CompressNs, NowNs() - startNs);
+    Metrics::Add(MetricCounter::CompressInputBytes, originalSize);
+
+    if (bodySize <= 0)
+    {
+        compressed->Close(0);
+        Metrics::Add(MetricCounter::CompressOutputBytes, originalSize);
+        return nullptr;
+    }
+
+    const uint16_t size = static_cast<uint16_t>(COMPRESSED_HEADER_SIZE + bodySize);
+    PacketHeader header{ size, COMPRESSED_PACKET_ID };
+    CompressedPacketHeader compressedHeader{ static_cast<uint8_t>(options.codec),
+        static_cast<uint8_t>(options.dictionary ? options.dictionary->GetId() : 0), static_cast<uint16_t>(originalSize) };
+
+    ::memcpy(compressed->Buffer(), &header, sizeof(header));
+    ::memcpy(compressed->Buffer() + sizeof(header), &compressedHeader, sizeof(compressedHeader));
+    compressed->Close(size);
+    compressed->SetDroppable(sendBuffer.IsDroppable());
+    compressed->SetCompressible(false);
+
+    Metrics::Add(MetricCounter::CompressOutputBytes, size);
+    return compressed;
+}
@@ -2,18 +2,22 @@
 #include "CoreGlobal.h"
 #include "SendBuffer.h"
 #include "ThreadManager.h"
+#include "GlobalQueue.h"
 
 ThreadManager* GThreadManager = nullptr;
 SendBufferManager* GSendBufferManager = nullptr;
+GlobalQueue* GGlobalQueue = nullptr;
 
 CoreGlobal::CoreGlobal()
 {
 	GThreadManager = new ThreadManager();
 	GSendBufferManager = new SendBufferManager();
+	GGlobalQueue = new GlobalQueue();
 }
 
 CoreGlobal::~CoreGlobal()
 {
 	delete GThreadManager;
 	delete GSendBufferManager;
+	delete GGlobalQueue;
 }
\ No newline at end of file
@@ -12,18 +12,30 @@
 #include "CoreTLS.h"
 #include "CoreGlobal.h"
 
+// 리눅스에서 SERVERCORE_IO_URING 을 정의하고 빌드하면 소켓 I/O 가 epoll 대신 io_uring 으로 돈다 (liburing 링크 필요)
+#if defined(__linux__) && defined(SERVERCORE_IO_URING)
+#define ASIO_HAS_IO_URING 1
+#define ASIO_DISABLE_EPOLL 1
+#endif
+
 #include <asio.hpp>
 
 #include <memory>
 #include <vector>
+#include <array>
+#include <span>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <system_error>
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <functional>
+#include <condition_variable>
+#include <future>
 
 ================================================================================
 // CorePch.cpp file content
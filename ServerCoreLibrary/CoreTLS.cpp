@@ -1,4 +1,6 @@
 #include "pch.h"
 #include "CoreTLS.h"
 
-thread_local __int32 LThreadId = 0;
\ No newline at end of file
+thread_local __int32 LThreadId = 0;
+thread_local uint64_t LEndTickCount = 0;
+thread_local JobQueue* LCurrentJobQueue = nullptr;
\ No newline at end of file
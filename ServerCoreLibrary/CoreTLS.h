@@ -1,6 +1,8 @@
 #pragma once
 
 extern thread_local __int32 LThreadId;
+extern thread_local uint64_t LEndTickCount;
+extern thread_local class JobQueue* LCurrentJobQueue;
 
 ================================================================================
 // CoreTLS.cpp file content
@@ -9,4 +11,6 @@ extern thread_local __int32 LThreadId;
 #include "pch.h"
 #include "CoreTLS.h"
 
-thread_local __int32 LThreadId = 0;
\ No newline at end of file
+thread_local __int32 LThreadId = 0;
+thread_local uint64_t LEndTickCount = 0;
+thread_local JobQueue* LCurrentJobQueue = nullptr;
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "CoroutineSession.h"
+#include "Service.h"
+
+CoroutineSession::CoroutineSession(asio::io_context& ioc)
+    : PacketSession(ioc)
+    , _strand(asio::make_strand(ioc))
+    , _sendWaiter(_strand)
+{
+}
+
+CoroutineSession::~CoroutineSession()
+{
+}
+
+void CoroutineSession::BeginRecv()
+{
+    if (_recvBuffer == nullptr)
+    {
+        std::shared_ptr<Service> service = GetService();
+        _recvBuffer = std::make_unique<RecvBuffer>(service ? service->GetRecvBufferSize() : BUFFER_SIZE);
+    }
+
+    // Ϸ ڵ鷯   Ƿ Run      ִ
+    asio::co_spawn(_strand, Run(),
+        [self = GetCoroutineSessionRef()](std::exception_ptr error)
+        {
+            self->Disconnect(DisconnectReason::User, error ? "Coroutine Exception" : "Coroutine End");
+        });
+}
+
+asio::awaitable<PacketView> CoroutineSession::ReadPacket()
+{
+    // ռ  Ŷ  ҺѴ
+    if (_pendingRead > 0)
+    {
+        _recvBuffer->OnRead(_pendingRead);
+        _recvBuffer->Clean();
+        _pendingRead = 0;
+    }
+
+    while (IsConnected())
+    {
+        //  Ŷ Ǭ    װͺ ϳ ش (Decompress  ϼ Ŷ Ȯߴ)
+        if (_inflatedOffset < _inflated.size())
+        {
+            PacketHeader header;
+            ::memcpy(&header, &_inflated[_inflatedOffset], sizeof(PacketHeader));
+
+            BYTE* packet = &_inflated[_inflatedOffset];
+            _inflatedOffset += header.size;
+            Metrics::Add(MetricCounter::RecvPackets);
+            co_return PacketView{ packet, header.size, header.id };
+        }
+
+        const int32_t dataSize = _recvBuffer->DataSize();
+        if (dataSize >= sizeof(PacketHeader))
+        {
+            PacketHeader header;
+            ::memcpy(&header, _recvBuffer->ReadPos(), sizeof(PacketHeader));
+
+            // ū ޽(size 0) PacketView ϳ   Ƿ  ʴ´
+            if (header.size < sizeof(PacketHeader))
+            {
+                Disconnect(DisconnectReason::InvalidPacket);
+                break;
+            }
+
+            if (dataSize >= header.size && header.id == COMPRESSED_PACKET_ID && IsCompressionEnabled())
+            {
+                std::span<BYTE> original = PacketCompressor::Decompress(_recvBuffer->ReadPos(), header.size, GetCompression());
+                if (original.empty())
+                {
+                    Disconnect(DisconnectReason::InvalidPacket);
+                    break;
+                }
+
+                _recvBuffer->OnRead(header.size);
+                _recvBuffer->Clean();
+                _inflated.assign(original.begin(), original.end());
+                _inflatedOffset = 0;
+                continue;
+            }
+
+            if (dataSize >= header.size)
+            {
+                _pendingRead = header.size;
+                Metrics::Add(MetricCounter::RecvPackets);
+                co_return PacketView{ _recvBuffer->ReadPos(), header.size, header.id };
+            }
+        }
+
+        // ۺ ū Ŷ   
+        if (_recvBuffer->FreeSize() == 0)
+        {
+            Disconnect(DisconnectReason::RecvBufferFull);
+            break;
+        }
+
+        std::error_code error;
+        const size_t bytesTransferred = co_await _socket.async_read_some(
+            asio::buffer(_recvBuffer->WritePos(), _recvBuffer->FreeSize()),
+            asio::redirect_error(asio::use_awaitable, error));
+
+        if (error)
+        {
+            if (error == asio::error::eof)
+                Disconnect(DisconnectReason::PeerClosed);
+            else
+                Disconnect(DisconnectReason::IoError, "ReadPacket Error");
+            break;
+        }
+
+        Metrics::Add(MetricCounter::RecvCalls);
+        Metrics::Add(MetricCounter::RecvBytes, bytesTransferred);
+        if (_recvIdleTimeoutMs > 0)
+            _lastRecvMs.store(NowMs(), std::memory_order_relaxed);
+
+        _recvBuffer->OnWrite(static_cast<int32_t>(bytesTransferred));
+    }
+
+    co_return PacketView{ nullptr, 0, 0 };
+}
+
+asio::awaitable<bool> CoroutineSession::AsyncSend(std::shared_ptr<SendBuffer> sendBuffer)
+{
+    Send(std::move(sendBuffer));
+
+    // ۽ Ϸ ٸ 忡 Ƿ ü Ǯȴ ٽ Ȯϸ ٸ
+    // ü Ǯų(OnSendBackpressure) (CancelWaits) Ÿ̸Ӹ ؼ 
+    while (IsConnected() && _sendBackpressured.load())
+    {
+        _sendWaiter.expires_at(asio::steady_timer::time_point::max());
+        std::error_code error;
+        co_await _sendWaiter.async_wait(asio::redirect_error(asio::use_awaitable, error));
+    }
+
+    co_return IsConnected();
+}
+
+void CoroutineSession::OnSendBackpressure(bool backpressured, int64_t queuedBytes)
+{
+    if (backpressured == false)
+        WakeSender();
+}
+
+void CoroutineSession::WakeSender()
+{
+    asio::post(_strand, [self = GetCoroutineSessionRef()]() { self->_sendWaiter.cancel(); });
+}
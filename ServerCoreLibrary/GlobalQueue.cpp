@@ -0,0 +1,36 @@
+#include "pch.h"
+#include "GlobalQueue.h"
+#include "JobQueue.h"
+#include "ThreadManager.h"
+
+GlobalQueue::GlobalQueue()
+{
+}
+
+GlobalQueue::~GlobalQueue()
+{
+}
+
+void GlobalQueue::Push(JobQueueRef jobQueue)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _jobQueues.push_back(std::move(jobQueue));
+        _count.fetch_add(1);
+    }
+
+    // ڰ ִ Ŀ    Ѵ
+    GThreadManager->WakeWorker();
+}
+
+JobQueueRef GlobalQueue::Pop()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_jobQueues.empty())
+        return nullptr;
+
+    JobQueueRef jobQueue = std::move(_jobQueues.front());
+    _jobQueues.pop_front();
+    _count.fetch_sub(1);
+    return jobQueue;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+class JobQueue;
+using JobQueueRef = std::shared_ptr<JobQueue>;
+
+/*---------------
+    GlobalQueue
+----------------*/
+//   Ѱų ٸ ť  ̶ ٷ   JobQueue   д
+// Ǯ Ŀ RunIoWorker  ThreadManager::DoGlobalQueueWork   ̾ Ѵ
+// Ǯ  JobQueue::Push    尡    ڸ 
+class GlobalQueue
+{
+public:
+    GlobalQueue();
+    ~GlobalQueue();
+
+    void        Push(JobQueueRef jobQueue);
+    JobQueueRef Pop();
+    bool        IsEmpty() const { return _count.load() == 0; }
+
+private:
+    std::mutex              _lock;
+    std::deque<JobQueueRef> _jobQueues;
+    std::atomic<int32_t>    _count = 0;
+};
+
+================================================================================
+// GlobalQueue.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "GlobalQueue.h"
+#include "JobQueue.h"
+#include "ThreadManager.h"
+
+GlobalQueue::GlobalQueue()
+{
+}
+
+GlobalQueue::~GlobalQueue()
+{
+}
+
+void GlobalQueue::Push(JobQueueRef jobQueue)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _jobQueues.push_back(std::move(jobQueue));
+        _count.fetch_add(1);
+    }
+
+    // ڰ ִ Ŀ    Ѵ
+    GThreadManager->WakeWorker();
+}
+
+JobQueueRef GlobalQueue::Pop()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_jobQueues.empty())
+        return nullptr;
+
+    JobQueueRef jobQueue = std::move(_jobQueues.front());
+    _jobQueues.pop_front();
+    _count.fetch_sub(1);
+    return jobQueue;
+}
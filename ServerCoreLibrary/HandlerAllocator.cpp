@@ -0,0 +1,35 @@
+#include "pch.h"
+#include "HandlerAllocator.h"
+#include "Metrics.h"
+
+/*-----------------
+    HandlerMemory
+------------------*/
+void* HandlerMemory::Allocate(size_t size)
+{
+    if (size <= SLOT_SIZE)
+    {
+        for (int32_t i = 0; i < SLOT_COUNT; i++)
+        {
+            // Ű ۽ ٸ 忡 ÿ   ִ
+            if (_inUse[i].load(std::memory_order_relaxed) == false && _inUse[i].exchange(true, std::memory_order_acquire) == false)
+                return _slots[i];
+        }
+    }
+
+    Metrics::Add(MetricCounter::HandlerHeapAllocs);
+    return ::operator new(size);
+}
+
+void HandlerMemory::Deallocate(void* pointer)
+{
+    BYTE* bytes = static_cast<BYTE*>(pointer);
+    if (bytes >= &_slots[0][0] && bytes < &_slots[0][0] + sizeof(_slots))
+    {
+        const int32_t index = static_cast<int32_t>((bytes - &_slots[0][0]) / SLOT_SIZE);
+        _inUse[index].store(false, std::memory_order_release);
+        return;
+    }
+
+    ::operator delete(pointer);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+/*-----------------
+    HandlerMemory
+------------------*/
+// 񵿱 ۾ (asio op)   . Ǹ ϳ д
+//  ǿ ÿ ɸ ۾  / ۽ / Ÿ̸     ϴ
+// Ժ ũų     ް MetricCounter::HandlerHeapAllocs  ø
+class HandlerMemory
+{
+    enum
+    {
+        SLOT_SIZE = 256,
+        SLOT_COUNT = 4,
+    };
+
+public:
+    HandlerMemory() = default;
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    void*   Allocate(size_t size);
+    void    Deallocate(void* pointer);
+
+private:
+    alignas(std::max_align_t) BYTE  _slots[SLOT_COUNT][SLOT_SIZE];
+    std::atomic<bool>               _inUse[SLOT_COUNT] = {};
+};
+
+/*--------------------
+    HandlerAllocator
+---------------------*/
+// HandlerMemory   ǥ Ҵ (asio  associated_allocator  δ)
+template<typename T>
+class HandlerAllocator
+{
+    template<typename U> friend class HandlerAllocator;
+
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory) noexcept : _memory(&memory) {}
+
+    template<typename U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept : _memory(other._memory) {}
+
+    T*      allocate(size_t count) { return static_cast<T*>(_memory->Allocate(sizeof(T) * count)); }
+    void    deallocate(T* pointer, size_t count) { _memory->Deallocate(pointer); }
+
+    template<typename U>
+    bool    operator==(const HandlerAllocator<U>& other) const noexcept { return _memory == other._memory; }
+    template<typename U>
+    bool    operator!=(const HandlerAllocator<U>& other) const noexcept { return _memory != other._memory; }
+
+private:
+    HandlerMemory* _memory;
+};
+
+/*----------------
+    AllocHandler
+-----------------*/
+// Ϸ ڵ鷯 μ ۾ ¸ HandlerMemory  Ҵϰ Ѵ
+// asio  ڵ鷯 ȣϱ  ޸𸮸 ֹǷ, ڵ鷯 ȿ  ۾ ɾ  ٽ 
+template<typename Handler>
+class AllocHandler
+{
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+
+    AllocHandler(HandlerMemory& memory, Handler handler)
+        : _memory(&memory), _handler(std::move(handler))
+    {
+    }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(*_memory); }
+
+    template<typename... Args>
+    void operator()(Args&&... args) { _handler(std::forward<Args>(args)...); }
+
+private:
+    HandlerMemory*  _memory;
+    Handler         _handler;
+};
+
+template<typename Handler>
+inline AllocHandler<std::decay_t<Handler>> MakeAllocHandler(HandlerMemory& memory, Handler&& handler)
+{
+    return AllocHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
+
+================================================================================
+// HandlerAllocator.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "HandlerAllocator.h"
+#include "Metrics.h"
+
+/*-----------------
+    HandlerMemory
+------------------*/
+void* HandlerMemory::Allocate(size_t size)
+{
+    if (size <= SLOT_SIZE)
+    {
+        for (int32_t i = 0; i < SLOT_COUNT; i++)
+        {
+            // Ű ۽ ٸ 忡 ÿ   ִ
+            if (_inUse[i].load(std::memory_order_relaxed) == false && _inUse[i].exchange(true, std::memory_order_acquire) == false)
+                return _slots[i];
+        }
+    }
+
+    Metrics::Add(MetricCounter::HandlerHeapAllocs);
+    return ::operator new(size);
+}
+
+void HandlerMemory::Deallocate(void* pointer)
+{
+    BYTE* bytes = static_cast<BYTE*>(pointer);
+    if (bytes >= &_slots[0][0] && bytes < &_slots[0][0] + sizeof(_slots))
+    {
+        const int32_t index = static_cast<int32_t>((bytes - &_slots[0][0]) / SLOT_SIZE);
+        _inUse[index].store(false, std::memory_order_release);
+        return;
+    }
+
+    ::operator delete(pointer);
+}
@@ -0,0 +1,140 @@
+#include "pch.h"
+#include "JobQueue.h"
+#include "GlobalQueue.h"
+#include "TimerWheel.h"
+#include "ThreadManager.h"
+
+JobQueue::~JobQueue()
+{
+    //     (   ִ 嵵 )
+    while (_jobCount.load() > 0)
+    {
+        if (MpscNode* node = _jobs.Pop())
+        {
+            delete static_cast<Job*>(node);
+            _jobCount.fetch_sub(1);
+        }
+    }
+}
+
+void JobQueue::DoTimer(asio::io_context& ioc, std::chrono::milliseconds delay, Job::CallbackType&& callback)
+{
+    TimerWheel::Get(ioc).Schedule(delay,
+        [owner = shared_from_this(), callback = std::move(callback)]() mutable
+        {
+            owner->DoAsync(std::move(callback));
+        });
+}
+
+void JobQueue::Push(Job* job, bool pushOnly)
+{
+    //   ÷   尡   ΰ  ʴ´
+    const int32_t prevCount = _jobCount.fetch_add(1);
+    _jobs.Push(job);
+
+    //  ־ų ϴ 尡    ٸ ٸ ̹   尡  ô´
+    if (prevCount != 0 && Unpark() == false)
+        return;
+
+    if (LCurrentJobQueue == nullptr && pushOnly == false)
+    {
+        //  ȿ        ְ  д
+        JobQueueRef self = shared_from_this();
+        Execute();
+
+        // Ǯ  Ѱ  JobQueue   尡 Ƿ ⼭ ̾ Ѵ
+        if (GThreadManager->IsWorkerRunning() == false)
+            DrainGlobalQueue();
+    }
+    else
+    {
+        GGlobalQueue->Push(shared_from_this());
+    }
+}
+
+void JobQueue::Execute()
+{
+    JobQueue* prevJobQueue = LCurrentJobQueue;
+    LCurrentJobQueue = this;
+
+    const uint64_t endTickCount = LEndTickCount != 0 ? LEndTickCount : GetTickCount() + DEFAULT_EXECUTE_TICK;
+
+    while (true)
+    {
+        int32_t executed = 0;
+        bool expired = false;
+
+        while (MpscNode* node = _jobs.Pop())
+        {
+            Job* job = static_cast<Job*>(node);
+            job->Execute();
+            delete job;
+            executed++;
+
+            if (GetTickCount() >= endTickCount)
+            {
+                expired = true;
+                break;
+            }
+        }
+
+        //  ŭ   0 ̸     
+        if (_jobCount.fetch_sub(executed) == executed)
+            break;
+
+        //   ٸ 尡 ̾ Ѵ
+        if (expired)
+        {
+            GGlobalQueue->Push(shared_from_this());
+            break;
+        }
+
+        // Pop  nullptr ̾µ   ִ  ڰ    ̴
+        // ٸ ʰ  ð д (ձ⸦  ڰ Push  ̾ Ѵ)
+        if (Park())
+            break;
+    }
+
+    LCurrentJobQueue = prevJobQueue;
+}
+
+bool JobQueue::Park()
+{
+    // SendQueue::Park  . ڴ    _parked  , ⼭ _parked     
+    _parked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_jobs.IsLinked() == false)
+        return true;
+
+    //   ̾.  ƹ ڵ  ʾ   Ѵ
+    return _parked.exchange(false) == false;
+}
+
+bool JobQueue::Unpark()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_parked.load(std::memory_order_relaxed) == false)
+        return false;
+
+    return _parked.exchange(false);
+}
+
+void JobQueue::DrainGlobalQueue()
+{
+    const uint64_t prevEndTickCount = LEndTickCount;
+
+    //  Ѱ ٽ  ť ٸ ť ڿ   
+    while (GGlobalQueue->IsEmpty() == false)
+    {
+        LEndTickCount = GetTickCount() + DEFAULT_EXECUTE_TICK;
+        ThreadManager::DoGlobalQueueWork();
+    }
+
+    LEndTickCount = prevEndTickCount;
+}
+
+uint64_t JobQueue::GetTickCount()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,218 @@
+#pragma once
+#include "LockFreeQueue.h"
+
+class JobQueue;
+using JobQueueRef = std::shared_ptr<JobQueue>;
+
+/*-------
+    Job
+--------*/
+// MpscQueue  ٷ  ħ 
+class Job : public MpscNode
+{
+public:
+    using CallbackType = std::function<void()>;
+
+    Job(CallbackType&& callback) : _callback(std::move(callback)) {}
+
+    void Execute() { _callback(); }
+
+private:
+    CallbackType _callback;
+};
+
+/*------------
+    JobQueue
+-------------*/
+// ó     忡,   Ѵ ( ȿ  ʿ )
+// -  ִ ť ó  尡  ڸ . ٸ ť ϴ ̸ GlobalQueue  ѱ
+// -  ð LEndTickCount     GlobalQueue  ѱ  (ٸ ť   ְ)
+// - GlobalQueue  Ǯ Ŀ / RunIoWorker  . Ǯ   þҴ 尡   
+// - ݵ make_shared   Ѵ (shared_from_this)
+class JobQueue : public std::enable_shared_from_this<JobQueue>
+{
+    enum { DEFAULT_EXECUTE_TICK = 64 };  // LEndTickCount    (I/O )   (ms)
+
+public:
+    JobQueue() = default;
+    JobQueue(const JobQueue&) = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+    virtual ~JobQueue();
+
+    void DoAsync(Job::CallbackType&& callback)
+    {
+        Push(new Job(std::move(callback)));
+    }
+
+    template<typename T, typename Ret, typename... Args>
+    void DoAsync(Ret(T::* memFunc)(Args...), Args... args)
+    {
+        std::shared_ptr<T> owner = std::static_pointer_cast<T>(shared_from_this());
+        Push(new Job([owner, memFunc, args...]() { (owner.get()->*memFunc)(args...); }));
+    }
+
+    // delay ڿ  ִ´ (ioc  TimerWheel )
+    void DoTimer(asio::io_context& ioc, std::chrono::milliseconds delay, Job::CallbackType&& callback);
+
+    // pushOnly ̸  忡  ʰ GlobalQueue  ѱ ( Ǯ Ŀ RunIoWorker  ־ Ѵ)
+    void Push(Job* job, bool pushOnly = false);
+    void Execute();
+
+    static uint64_t GetTickCount();
+
+private:
+    //   ִµ Pop      ð ΰ  (true    ڰ ̾ Ѵ)
+    bool Park();
+    bool Unpark();
+    static void DrainGlobalQueue();
+
+private:
+    MpscQueue               _jobs;
+    std::atomic<int32_t>    _jobCount = 0;
+    std::atomic<bool>       _parked = false;
+};
+
+================================================================================
+// JobQueue.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "JobQueue.h"
+#include "GlobalQueue.h"
+#include "TimerWheel.h"
+#include "ThreadManager.h"
+
+JobQueue::~JobQueue()
+{
+    //     (   ִ 嵵 )
+    while (_jobCount.load() > 0)
+    {
+        if (MpscNode* node = _jobs.Pop())
+        {
+            delete static_cast<Job*>(node);
+            _jobCount.fetch_sub(1);
+        }
+    }
+}
+
+void JobQueue::DoTimer(asio::io_context& ioc, std::chrono::milliseconds delay, Job::CallbackType&& callback)
+{
+    TimerWheel::Get(ioc).Schedule(delay,
+        [owner = shared_from_this(), callback = std::move(callback)]() mutable
+        {
+            owner->DoAsync(std::move(callback));
+        });
+}
+
+void JobQueue::Push(Job* job, bool pushOnly)
+{
+    //   ÷   尡   ΰ  ʴ´
+    const int32_t prevCount = _jobCount.fetch_add(1);
+    _jobs.Push(job);
+
+    //  ־ų ϴ 尡    ٸ ٸ ̹   尡  ô´
+    if (prevCount != 0 && Unpark() == false)
+        return;
+
+    if (LCurrentJobQueue == nullptr && pushOnly == false)
+    {
+        //  ȿ        ְ  д
+        JobQueueRef self = shared_from_this();
+        Execute();
+
+        // Ǯ  Ѱ  JobQueue   尡 Ƿ ⼭ ̾ Ѵ
+        if (GThreadManager->IsWorkerRunning() == false)
+            DrainGlobalQueue();
+    }
+    else
+    {
+        GGlobalQueue->Push(shared_from_this());
+    }
+}
+
+void JobQueue::Execute()
+{
+    JobQueue* prevJobQueue = LCurrentJobQueue;
+    LCurrentJobQueue = this;
+
+    const uint64_t endTickCount = LEndTickCount != 0 ? LEndTickCount : GetTickCount() + DEFAULT_EXECUTE_TICK;
+
+    while (true)
+    {
+        int32_t executed = 0;
+        bool expired = false;
+
+        while (MpscNode* node = _jobs.Pop())
+        {
+            Job* job = static_cast<Job*>(node);
+            job->Execute();
+            delete job;
+            executed++;
+
+            if (GetTickCount() >= endTickCount)
+            {
+                expired = true;
+                break;
+            }
+        }
+
+        //  ŭ   0 ̸     
+        if (_jobCount.fetch_sub(executed) == executed)
+            break;
+
+        //   ٸ 尡 ̾ Ѵ
+        if (expired)
+        {
+            GGlobalQueue->Push(shared_from_this());
+            break;
+        }
+
+        // Pop  nullptr ̾µ   ִ  ڰ    ̴
+        // ٸ ʰ  ð д (ձ⸦  ڰ Push  ̾ Ѵ)
+        if (Park())
+            break;
+    }
+
+    LCurrentJobQueue = prevJobQueue;
+}
+
+bool JobQueue::Park()
+{
+    // SendQueue::Park  . ڴ    _parked  , ⼭ _parked     
+    _parked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_jobs.IsLinked() == false)
+        return true;
+
+    //   ̾.  ƹ ڵ  ʾ   Ѵ
+    return _parked.exchange(false) == false;
+}
+
+bool JobQueue::Unpark()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_parked.load(std::memory_order_relaxed) == false)
+        return false;
+
+    return _parked.exchange(false);
+}
+
+void JobQueue::DrainGlobalQueue()
+{
+    const uint64_t prevEndTickCount = LEndTickCount;
+
+    //  Ѱ ٽ  ť ٸ ť ڿ   
+    while (GGlobalQueue->IsEmpty() == false)
+    {
+        LEndTickCount = GetTickCount() + DEFAULT_EXECUTE_TICK;
+        ThreadManager::DoGlobalQueueWork();
+    }
+
+    LEndTickCount = prevEndTickCount;
+}
+
+uint64_t JobQueue::GetTickCount()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -4,10 +4,35 @@ class Session;
 class Service;
 class ServerService;
 
+/*----------------
+    Listener
+-----------------*/
+//  acceptor  ó
+// - reusePort  Ѱ SO_REUSEPORT  ϸ io_context() acceptor  ϳ  Ŀ  лѴ
+//    Ʈ ̹ listen       ǹǷ  ʰ Ѵ
+// -  ۿ (⺻, Windows) acceptor ϳ accept    ɾ д
+// - acceptor  pendingAcceptCount ŭ async_accept  ÿ ɾ д
+// - accept  ϸ (fd  ) ٷ ٽ  ʰ  þ (10ms ~ 1s) ΰ ٽ Ǵ
 class Listener : public std::enable_shared_from_this<Listener>
 {
+    enum
+    {
+        ACCEPT_BACKOFF_MIN_MS = 10,
+        ACCEPT_BACKOFF_MAX_MS = 1000,
+    };
+
+    struct Acceptor
+    {
+        Acceptor(asio::io_context& ioc) : ioContext(ioc), acceptor(ioc) {}
+
+        asio::io_context&       ioContext;
+        asio::ip::tcp::acceptor acceptor;
+        std::atomic<int32_t>    backoffMs = 0;  //  ϴ  þ. ϸ 0
+    };
+
 public:
-    Listener(asio::io_context& ioc, const asio::ip::tcp::endpoint& endpoint);
+    Listener(const asio::ip::tcp::endpoint& endpoint,
+        int32_t backlog = asio::socket_base::max_listen_connections, int32_t pendingAcceptCount = 4, bool reusePort = false);
     ~Listener();
 
 public:
@@ -15,16 +40,28 @@ public:
     bool StartAccept(std::shared_ptr<ServerService> service);
     void Stop();
 
+    /* Info */
+    uint64_t GetAcceptCount() const { return _acceptCount.load(std::memory_order_relaxed); }
+    int32_t  GetAcceptorCount() const { return static_cast<int32_t>(_acceptors.size()); }
+
 private:
     /* Accept Related */
-    void RegisterAccept();
-    void HandleAccept(std::shared_ptr<Session> session, const std::error_code& error);
+    bool OpenAcceptor(asio::io_context& ioc, bool reusePort);
+    bool IsPortInUse(asio::io_context& ioc);
+    void RegisterAccept(Acceptor* acceptor);
+    void HandleAccept(Acceptor* acceptor, std::shared_ptr<Session> session, const std::error_code& error);
 
 private:
-    asio::io_context& _ioContext;
-    asio::ip::tcp::acceptor _acceptor;
-    std::shared_ptr<ServerService> _service;
-    bool _isRunning = false;
+    asio::ip::tcp::endpoint   _endpoint;
+    int32_t                   _backlog;
+    int32_t                   _pendingAcceptCount;
+    bool                      _useReusePort;        // û 
+    bool                      _reusePort = false;   //  帶 acceptor  
+
+    std::vector<std::unique_ptr<Acceptor>> _acceptors;
+    std::weak_ptr<ServerService> _service;
+    std::atomic<bool>         _isRunning = false;
+    std::atomic<uint64_t>     _acceptCount = 0;
 };
 
 ================================================================================
@@ -35,13 +72,36 @@ private:
 #include "Listener.h"
 #include "Session.h"
 #include "Service.h"
+#include "AsioCore.h"
+#include "TimerWheel.h"
 #include <iostream>
 
-Listener::Listener(asio::io_context& ioc, const asio::ip::tcp::endpoint& endpoint)
-    : _ioContext(ioc)
-    , _acceptor(ioc, endpoint)
+#ifdef SO_REUSEPORT
+namespace
+{
+    // asio  SO_REUSEPORT ɼ  SettableSocketOption 䱸 ״ 
+    class ReusePort
+    {
+    public:
+        explicit ReusePort(bool enable) : _value(enable ? 1 : 0) {}
+
+        template<typename Protocol> int level(const Protocol&) const { return SOL_SOCKET; }
+        template<typename Protocol> int name(const Protocol&) const { return SO_REUSEPORT; }
+        template<typename Protocol> const void* data(const Protocol&) const { return &_value; }
+        template<typename Protocol> size_t size(const Protocol&) const { return sizeof(_value); }
+
+    private:
+        int _value;
+    };
+}
+#endif
+
+Listener::Listener(const asio::ip::tcp::endpoint& endpoint, int32_t backlog, int32_t pendingAcceptCount, bool reusePort)
+    : _endpoint(endpoint)
+    , _backlog(backlog)
+    , _pendingAcceptCount(std::max(1, pendingAcceptCount))
+    , _useReusePort(reusePort)
 {
-    _acceptor.set_option(asio::ip::tcp::acceptor::reuse_address(true));
 }
 
 Listener::~Listener()
@@ -51,14 +111,59 @@ Listener::~Listener()
 
 bool Listener::StartAccept(std::shared_ptr<ServerService> service)
 {
-    _service = service;
-    if (!_service)
+    if (!service)
         return false;
 
+    _service = service;
+
+    // acceptor   io_context 
+    std::vector<asio::io_context*> contexts;
+    AsiocCore* core = service->GetAsioCore();
+    if (core && core->IsSharded())
+    {
+        for (int32_t i = 0; i < core->GetShardCount(); i++)
+            contexts.push_back(&core->GetIoContext(i));
+    }
+    else
+    {
+        contexts.push_back(&service->GetIOContext());
+    }
+
+    // Ʈ 0 ̸ acceptor  ٸ Ʈ ް ǹǷ ϳ 
+    _reusePort = false;
+#ifdef SO_REUSEPORT
+    if (_useReusePort && contexts.size() > 1 && _endpoint.port() != 0)
+    {
+        if (IsPortInUse(*contexts[0]))
+        {
+            std::cerr << "Port already in use, SO_REUSEPORT listener not started: " << _endpoint.port() << std::endl;
+            return false;
+        }
+        _reusePort = true;
+    }
+#endif
+
+    // SO_REUSEPORT     Ʈ acceptor      
+    if (_reusePort == false)
+        contexts.resize(1);
+
+    for (asio::io_context* ioc : contexts)
+    {
+        if (!OpenAcceptor(*ioc, _reusePort))
+        {
+            Stop();
+            return false;
+        }
+    }
+
     _isRunning = true;
 
     // Start accepting connections
-    RegisterAccept();
+    for (const auto& acceptor : _acceptors)
+    {
+        for (int32_t i = 0; i < _pendingAcceptCount; i++)
+            RegisterAccept(acceptor.get());
+    }
 
     return true;
 }
@@ -68,48 +173,143 @@ void Listener::Stop()
     _isRunning = false;
 
     std::error_code ec;
-    _acceptor.close(ec);
+    for (const auto& acceptor : _acceptors)
+        acceptor->acceptor.close(ec);
+}
 
-    _service = nullptr;
+bool Listener::OpenAcceptor(asio::io_context& ioc, bool reusePort)
+{
+    auto acceptor = std::make_unique<Acceptor>(ioc);
+    asio::ip::tcp::acceptor& socket = acceptor->acceptor;
+
+    std::error_code ec;
+    socket.open(_endpoint.protocol(), ec);
+    if (ec)
+        return false;
+
+    socket.set_option(asio::ip::tcp::acceptor::reuse_address(true), ec);
+#ifdef SO_REUSEPORT
+    if (reusePort)
+        socket.set_option(ReusePort(true), ec);
+#endif
+
+    socket.bind(_endpoint, ec);
+    if (ec)
+    {
+        std::cerr << "Bind failed: " << ec.message() << std::endl;
+        return false;
+    }
+
+    socket.listen(_backlog, ec);
+    if (ec)
+    {
+        std::cerr << "Listen failed: " << ec.message() << std::endl;
+        return false;
+    }
+
+    _acceptors.push_back(std::move(acceptor));
+    return true;
+}
+
+bool Listener::IsPortInUse(asio::io_context& ioc)
+{
+    // SO_REUSEPORT  bind   ̹ listen  (ٸ μ ) ִ   ִ
+    asio::ip::tcp::acceptor probe(ioc);
+
+    std::error_code ec;
+    probe.open(_endpoint.protocol(), ec);
+    if (ec)
+        return false;
+
+    probe.set_option(asio::ip::tcp::acceptor::reuse_address(true), ec);
+    probe.bind(_endpoint, ec);
+    const bool inUse = ec == asio::error::address_in_use;
+
+    probe.close(ec);
+    return inUse;
 }
 
-void Listener::RegisterAccept()
+void Listener::RegisterAccept(Acceptor* acceptor)
 {
     if (!_isRunning)
         return;
-    /*
-    std::shared_ptr<Session> session = _service->CreateSession();
+
+    std::shared_ptr<ServerService> service = _service.lock();
+    if (!service)
+        return;
+
+    // acceptor  ڱ 忡     带 ű ʿ䰡 
+    std::shared_ptr<Session> session = _reusePort
+        ? service->CreateSession(acceptor->ioContext)
+        : service->CreateSession();
     if (!session)
         return;
 
-    _acceptor.async_accept(
+    // accept ۾ µ   Կ д
+    acceptor->acceptor.async_accept(
         session->GetSocket(),
-        [this, session](const std::error_code& error)
+        MakeAllocHandler(session->_handlerMemory, [self = shared_from_this(), acceptor, session](const std::error_code& error)
         {
-            HandleAccept(session, error);
-        });
-    */
+            self->HandleAccept(acceptor, session, error);
+        }));
 }
 
-void Listener::HandleAccept(std::shared_ptr<Session> session, const std::error_code& error)
+void Listener::HandleAccept(Acceptor* acceptor, std::shared_ptr<Session> session, const std::error_code& error)
 {
     if (!_isRunning)
         return;
 
+    std::shared_ptr<ServerService> service = _service.lock();
+    if (!service)
+        return;
+
     if (!error)
     {
+        acceptor->backoffMs.store(0, std::memory_order_relaxed);
+        _acceptCount.fetch_add(1, std::memory_order_relaxed);
+        Metrics::Add(MetricCounter::Accepts);
+
         std::error_code ec;
         auto endpoint = session->GetSocket().remote_endpoint(ec);
         if (!ec)
         {
             session->SetNetAddress(endpoint);
-            //session->ProcessConnect();
+
+            if (service->GetCurrentSessionCount() < service->GetMaxSessionCount())
+            {
+                //  recv/send/ ó   io_context   ѱ
+                asio::dispatch(session->GetIoContext(), [session]()
+                    {
+                        session->ProcessConnect();
+                    });
+            }
+            else
+            {
+                //   ʰǸ  ź
+                session->GetSocket().close(ec);
+            }
         }
     }
+    else if (error == asio::error::operation_aborted)
+    {
+        return;
+    }
     else
     {
-        std::cerr << "Accept failed: " << error.message() << std::endl;
+        // fd  ڶ  ٷ ٽ ɸ  и ݺϸ I/O 带 ¿
+        const int32_t prevBackoffMs = acceptor->backoffMs.load(std::memory_order_relaxed);
+        const int32_t backoffMs = std::clamp(prevBackoffMs * 2, static_cast<int32_t>(ACCEPT_BACKOFF_MIN_MS), static_cast<int32_t>(ACCEPT_BACKOFF_MAX_MS));
+        acceptor->backoffMs.store(backoffMs, std::memory_order_relaxed);
+
+        Metrics::Add(MetricCounter::AcceptErrors);
+        service->OnAcceptError(error, std::chrono::milliseconds(backoffMs));
+
+        TimerWheel::Get(acceptor->ioContext).Schedule(std::chrono::milliseconds(backoffMs), [self = shared_from_this(), acceptor]()
+            {
+                self->RegisterAccept(acceptor);
+            });
+        return;
     }
 
-    RegisterAccept();
-}
\ No newline at end of file
+    RegisterAccept(acceptor);
+}
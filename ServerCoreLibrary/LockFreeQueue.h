@@ -0,0 +1,293 @@
+#pragma once
+
+/*----------------
+    MpscNode
+-----------------*/
+struct MpscNode
+{
+    std::atomic<MpscNode*> next = nullptr;
+};
+
+/*----------------
+    MpscQueue
+-----------------*/
+// ħ(intrusive) Multi-Producer / Single-Consumer ť (Vyukov)
+// - Push :  忡 ȣ , exchange    (wait-free)
+// - Pop  : Һ  ϳ ȣ
+// ڰ exchange  next  ̿   Pop   nullptr    ִ.
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : _head(&_stub), _tail(&_stub)
+    {
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void Push(MpscNode* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // first ~ last  ̸ ̾     ִ´ (ٸ  尡 ̿  ʴ´)
+    void PushChain(MpscNode* first, MpscNode* last)
+    {
+        last->next.store(nullptr, std::memory_order_relaxed);
+        MpscNode* prev = _head.exchange(last, std::memory_order_acq_rel);
+        prev->next.store(first, std::memory_order_release);
+    }
+
+    MpscNode* Pop()
+    {
+        MpscNode* tail = _tail;
+        MpscNode* next = tail->next.load(std::memory_order_acquire);
+
+        if (tail == &_stub)
+        {
+            if (next == nullptr)
+                return nullptr;
+
+            _tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        if (next)
+        {
+            _tail = next;
+            return tail;
+        }
+
+        // ڰ  next    
+        if (tail != _head.load(std::memory_order_acquire))
+            return nullptr;
+
+        //  带   stub  ٽ ִ´
+        Push(&_stub);
+
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            _tail = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+
+    //  Pop  带    ŭ  ִ (Һ 忡)
+    bool IsLinked() const
+    {
+        MpscNode* tail = _tail;
+        MpscNode* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &_stub || next)
+            return next != nullptr;
+
+        return tail == _head.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<MpscNode*> _head;   //  
+    alignas(64) MpscNode*              _tail;   // Һ 
+    MpscNode                           _stub;
+};
+
+/*--------------------
+    LockFreeStackNode
+---------------------*/
+struct LockFreeStackNode
+{
+    std::atomic<LockFreeStackNode*> next = nullptr;
+};
+
+/*----------------
+    LockFreeStack
+-----------------*/
+// ħ Treiber .  16Ʈ ±׷ ABA  ´.
+// Pop ߿ ٸ 尡   next    Ƿ,
+//  ޸𸮴    Ǹ  ȴ (Ǯ ü ).
+class LockFreeStack
+{
+    enum : uint64_t
+    {
+        POINTER_BITS = 48,
+        POINTER_MASK = (1ull << POINTER_BITS) - 1,
+    };
+
+public:
+    LockFreeStack() = default;
+
+    LockFreeStack(const LockFreeStack&) = delete;
+    LockFreeStack& operator=(const LockFreeStack&) = delete;
+
+    void Push(LockFreeStackNode* node)
+    {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            node->next.store(ToNode(head), std::memory_order_relaxed);
+            if (_head.compare_exchange_weak(head, Pack(node, Tag(head) + 1),
+                std::memory_order_release, std::memory_order_relaxed))
+                break;
+        }
+        _count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LockFreeStackNode* Pop()
+    {
+        uint64_t head = _head.load(std::memory_order_acquire);
+        while (true)
+        {
+            LockFreeStackNode* node = ToNode(head);
+            if (node == nullptr)
+                return nullptr;
+
+            LockFreeStackNode* next = node->next.load(std::memory_order_relaxed);
+            if (_head.compare_exchange_weak(head, Pack(next, Tag(head) + 1),
+                std::memory_order_acquire, std::memory_order_acquire))
+            {
+                _count.fetch_sub(1, std::memory_order_relaxed);
+                return node;
+            }
+        }
+    }
+
+    int32_t Count() const { return _count.load(std::memory_order_relaxed); }
+
+private:
+    static LockFreeStackNode* ToNode(uint64_t value) { return reinterpret_cast<LockFreeStackNode*>(static_cast<uintptr_t>(value & POINTER_MASK)); }
+    static uint64_t Tag(uint64_t value) { return value >> POINTER_BITS; }
+    static uint64_t Pack(LockFreeStackNode* node, uint64_t tag)
+    {
+        return (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node)) & POINTER_MASK) | (tag << POINTER_BITS);
+    }
+
+private:
+    alignas(64) std::atomic<uint64_t> _head = 0;
+    std::atomic<int32_t>              _count = 0;
+};
+
+/*----------------------
+    WorkStealingDeque
+-----------------------*/
+// Chase-Lev ۾ ġ  (Le et al.  C11 ޸  )
+// - Push / Pop :   ϳ, Ʒ(bottom) LIFO
+// - Steal      : ƹ 峪, (top) FIFO. տ    ʾƵ nullptr
+// 迭    Ű. ٸ 尡  迭 а   ־     .
+template<typename T>
+class WorkStealingDeque
+{
+    static_assert(std::is_pointer_v<T>, "WorkStealingDeque holds pointers only");
+
+    struct Array
+    {
+        explicit Array(int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), buffer(new std::atomic<T>[capacity])
+        {
+        }
+
+        T    Get(int64_t index) const { return buffer[index & mask].load(std::memory_order_relaxed); }
+        void Put(int64_t index, T value) { buffer[index & mask].store(value, std::memory_order_relaxed); }
+
+        int64_t                         capacity;
+        int64_t                         mask;
+        std::unique_ptr<std::atomic<T>[]> buffer;
+    };
+
+public:
+    explicit WorkStealingDeque(int64_t capacity = 256)
+    {
+        _arrays.push_back(std::make_unique<Array>(capacity));
+        _array.store(_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    void Push(T value)
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_acquire);
+        Array* array = _array.load(std::memory_order_relaxed);
+
+        if (bottom - top > array->capacity - 1)
+            array = Grow(array, bottom, top);
+
+        array->Put(bottom, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        _bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    T Pop()
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = _array.load(std::memory_order_relaxed);
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            //  ִ
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T value = array->Get(bottom);
+        if (top == bottom)
+        {
+            //  ϳ ġ ʰ top  Ѵ
+            if (_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false)
+                value = nullptr;
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    T Steal()
+    {
+        int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+            return nullptr;
+
+        Array* array = _array.load(std::memory_order_acquire);
+        T value = array->Get(top);
+        if (_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) == false)
+            return nullptr;
+
+        return value;
+    }
+
+    int64_t Size() const
+    {
+        const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        const int64_t top = _top.load(std::memory_order_relaxed);
+        return bottom > top ? bottom - top : 0;
+    }
+
+private:
+    Array* Grow(Array* array, int64_t bottom, int64_t top)
+    {
+        auto newArray = std::make_unique<Array>(array->capacity * 2);
+        for (int64_t i = top; i < bottom; i++)
+            newArray->Put(i, array->Get(i));
+
+        Array* raw = newArray.get();
+        _arrays.push_back(std::move(newArray));
+        _array.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t>    _top = 0;       // ġ 
+    alignas(64) std::atomic<int64_t>    _bottom = 0;    //  
+    std::atomic<Array*>                 _array = nullptr;
+    std::vector<std::unique_ptr<Array>> _arrays;        //  常 ǵ帰
+};
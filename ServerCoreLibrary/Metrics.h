@@ -0,0 +1,493 @@
+#pragma once
+
+// Session::Disconnect 
+enum class DisconnectReason : uint8_t
+{
+    None,
+    User,               //  ڵ忡 Disconnect(const char*)
+    PeerClosed,         // 밡   (eof)
+    IoError,            // recv / send / connect 
+    RecvBufferFull,     // ۺ ū Ŷ
+    ReadOverflow,       // OnRecv  ߸ ̸  (  )
+    InvalidPacket,      // ϵ  Ŷ id
+    SendBackpressure,   // ۽ ť ü å
+    IdleTimeout,        //   ð ʰ
+    ServiceClose,
+    Destructor,
+
+    COUNT
+};
+
+const char* ToString(DisconnectReason reason);
+
+enum class MetricCounter : uint8_t
+{
+    RecvBytes,
+    RecvCalls,
+    RecvPackets,
+    SendBytes,
+    SendCalls,
+    SendBuffers,
+    Accepts,
+    AcceptErrors,           // ߴ(operation_aborted)  accept  (EMFILE )
+    SessionsOpened,
+    RecvBufferMoveBytes,    // RecvBuffer::Clean    Ʈ (   )
+    HandlerHeapAllocs,      // HandlerMemory Կ     ڵ鷯 ( ¿ 0)
+    CompressInputBytes,     //  õ  Ʈ
+    CompressOutputBytes,    //   Ʈ ( ʾ     ũ)
+    CompressNs,             // ࿡  ð
+    DecompressNs,           //    ð
+
+    COUNT
+};
+
+enum class MetricHistogram : uint8_t
+{
+    HandlerLatencyNs,       //     OnRecv ó ð
+    SendQueueDepth,         // ⸦   ۽ ť  ִ  
+
+    COUNT
+};
+
+/*-------------------
+    MetricsSnapshot
+--------------------*/
+struct MetricsSnapshot
+{
+    enum { HISTOGRAM_BUCKETS = 41 };   // [0] 0, [i] 2^(i-1) ̻ 2^i ̸, [40]  ̻
+
+    struct Histogram
+    {
+        std::array<uint64_t, HISTOGRAM_BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t sum = 0;
+    };
+
+    std::array<uint64_t, static_cast<size_t>(MetricCounter::COUNT)>       counters{};
+    std::array<uint64_t, static_cast<size_t>(DisconnectReason::COUNT)>    disconnects{};
+    std::array<Histogram, static_cast<size_t>(MetricHistogram::COUNT)>    histograms{};
+
+    uint64_t Get(MetricCounter counter) const { return counters[static_cast<size_t>(counter)]; }
+    uint64_t Get(DisconnectReason reason) const { return disconnects[static_cast<size_t>(reason)]; }
+
+    // Prometheus text exposition format (0.0.4)
+    std::string ToPrometheus() const;
+};
+
+/*-----------
+    Metrics
+------------*/
+// 帶 ĳ    ī.   ڱ  ͸ ǵ帮Ƿ  ,
+// Snapshot  θ     ģ
+class Metrics
+{
+public:
+    static void Add(MetricCounter counter, uint64_t value = 1);
+    static void Observe(MetricHistogram histogram, uint64_t value);
+    static void AddDisconnect(DisconnectReason reason);
+
+    static MetricsSnapshot Snapshot();
+    // θ 尡   (  ̿ ̾ Ƿ  /     ̷ )
+    static MetricsSnapshot ThreadSnapshot();
+};
+
+/*-------------------
+    MetricsExporter
+--------------------*/
+// Snapshot  Prometheus ؽƮ 
+//  - StartHttp :  Ʈ  û    ش (scrape )
+//  - StartCallback : intervalMs  ݹ ѱ (α, , push gateway )
+class MetricsExporter : public std::enable_shared_from_this<MetricsExporter>
+{
+    enum
+    {
+        ACCEPT_BACKOFF_MIN_MS = 10,
+        ACCEPT_BACKOFF_MAX_MS = 1000,
+    };
+
+public:
+    using ExportCallback = std::function<void(const std::string&)>;
+
+    MetricsExporter(asio::io_context& ioc);
+    ~MetricsExporter();
+
+    bool StartHttp(const asio::ip::tcp::endpoint& endpoint);
+    void StartCallback(int32_t intervalMs, ExportCallback callback);
+    void Stop();
+
+private:
+    void RegisterAccept();
+    void RegisterTimer();
+
+private:
+    asio::io_context&                       _ioc;
+    std::unique_ptr<asio::ip::tcp::acceptor> _acceptor;
+    std::unique_ptr<asio::steady_timer>     _timer;
+    std::chrono::milliseconds               _interval{ 0 };
+    ExportCallback                          _callback;
+    std::atomic<bool>                       _isRunning = false;
+    int32_t                                 _acceptBackoffMs = 0;   // accept   ϴ  þ (accept    ϳ ɸ)
+};
+
+================================================================================
+// Metrics.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "Metrics.h"
+#include "TimerWheel.h"
+#include <bit>
+#include <cstdio>
+
+namespace
+{
+    constexpr size_t COUNTER_COUNT = static_cast<size_t>(MetricCounter::COUNT);
+    constexpr size_t REASON_COUNT = static_cast<size_t>(DisconnectReason::COUNT);
+    constexpr size_t HISTOGRAM_COUNT = static_cast<size_t>(MetricHistogram::COUNT);
+    constexpr size_t BUCKET_COUNT = MetricsSnapshot::HISTOGRAM_BUCKETS;
+
+    //  常 Ƿ fetch_add  load + store  ø (д     ʰ atomic  )
+    inline void Increase(std::atomic<uint64_t>& value, uint64_t delta)
+    {
+        value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    struct alignas(64) MetricsShard
+    {
+        std::atomic<uint64_t> counters[COUNTER_COUNT] = {};
+        std::atomic<uint64_t> disconnects[REASON_COUNT] = {};
+        std::atomic<uint64_t> buckets[HISTOGRAM_COUNT][BUCKET_COUNT] = {};
+        std::atomic<uint64_t> sums[HISTOGRAM_COUNT] = {};
+        bool                  inUse = false;     // Ʈ  ȣ
+    };
+
+    // 尡   ̹Ƿ   ʰ  尡 ̾ 
+    struct MetricsRegistry
+    {
+        std::mutex                                  lock;
+        std::vector<std::unique_ptr<MetricsShard>>  shards;
+
+        MetricsShard* Acquire()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            for (const std::unique_ptr<MetricsShard>& shard : shards)
+            {
+                if (shard->inUse == false)
+                {
+                    shard->inUse = true;
+                    return shard.get();
+                }
+            }
+
+            shards.push_back(std::make_unique<MetricsShard>());
+            shards.back()->inUse = true;
+            return shards.back().get();
+        }
+
+        void Release(MetricsShard* shard)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            shard->inUse = false;
+        }
+    };
+
+    //      ֵ  ʴ´
+    MetricsRegistry& GetRegistry()
+    {
+        static MetricsRegistry* registry = new MetricsRegistry();
+        return *registry;
+    }
+
+    struct LocalMetricsShard
+    {
+        MetricsShard* shard = GetRegistry().Acquire();
+        ~LocalMetricsShard() { GetRegistry().Release(shard); }
+    };
+
+    thread_local LocalMetricsShard LMetricsShard;
+
+    void AddShard(MetricsSnapshot& snapshot, const MetricsShard& shard)
+    {
+        for (size_t i = 0; i < COUNTER_COUNT; i++)
+            snapshot.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < REASON_COUNT; i++)
+            snapshot.disconnects[i] += shard.disconnects[i].load(std::memory_order_relaxed);
+
+        for (size_t h = 0; h < HISTOGRAM_COUNT; h++)
+        {
+            MetricsSnapshot::Histogram& histogram = snapshot.histograms[h];
+            for (size_t b = 0; b < BUCKET_COUNT; b++)
+            {
+                const uint64_t count = shard.buckets[h][b].load(std::memory_order_relaxed);
+                histogram.buckets[b] += count;
+                histogram.count += count;
+            }
+            histogram.sum += shard.sums[h].load(std::memory_order_relaxed);
+        }
+    }
+
+    const char* CounterName(MetricCounter counter)
+    {
+        switch (counter)
+        {
+        case MetricCounter::RecvBytes:              return "servercore_recv_bytes_total";
+        case MetricCounter::RecvCalls:              return "servercore_recv_calls_total";
+        case MetricCounter::RecvPackets:            return "servercore_recv_packets_total";
+        case MetricCounter::SendBytes:              return "servercore_send_bytes_total";
+        case MetricCounter::SendCalls:              return "servercore_send_calls_total";
+        case MetricCounter::SendBuffers:            return "servercore_send_buffers_total";
+        case MetricCounter::Accepts:                return "servercore_accepts_total";
+        case MetricCounter::AcceptErrors:           return "servercore_accept_errors_total";
+        case MetricCounter::SessionsOpened:         return "servercore_sessions_opened_total";
+        case MetricCounter::RecvBufferMoveBytes:    return "servercore_recv_buffer_move_bytes_total";
+        case MetricCounter::HandlerHeapAllocs:      return "servercore_handler_heap_allocs_total";
+        case MetricCounter::CompressInputBytes:     return "servercore_compress_input_bytes_total";
+        case MetricCounter::CompressOutputBytes:    return "servercore_compress_output_bytes_total";
+        case MetricCounter::CompressNs:             return "servercore_compress_ns_total";
+        case MetricCounter::DecompressNs:           return "servercore_decompress_ns_total";
+        default:                                    return "servercore_unknown_total";
+        }
+    }
+
+    const char* HistogramName(MetricHistogram histogram)
+    {
+        switch (histogram)
+        {
+        case MetricHistogram::HandlerLatencyNs:     return "servercore_handler_latency_ns";
+        case MetricHistogram::SendQueueDepth:       return "servercore_send_queue_depth";
+        default:                                    return "servercore_unknown";
+        }
+    }
+}
+
+const char* ToString(DisconnectReason reason)
+{
+    switch (reason)
+    {
+    case DisconnectReason::None:                return "none";
+    case DisconnectReason::User:                return "user";
+    case DisconnectReason::PeerClosed:          return "peer_closed";
+    case DisconnectReason::IoError:             return "io_error";
+    case DisconnectReason::RecvBufferFull:      return "recv_buffer_full";
+    case DisconnectReason::ReadOverflow:        return "read_overflow";
+    case DisconnectReason::InvalidPacket:       return "invalid_packet";
+    case DisconnectReason::SendBackpressure:    return "send_backpressure";
+    case DisconnectReason::IdleTimeout:         return "idle_timeout";
+    case DisconnectReason::ServiceClose:        return "service_close";
+    case DisconnectReason::Destructor:          return "destructor";
+    default:                                    return "unknown";
+    }
+}
+
+/*-----------
+    Metrics
+------------*/
+void Metrics::Add(MetricCounter counter, uint64_t value)
+{
+    Increase(LMetricsShard.shard->counters[static_cast<size_t>(counter)], value);
+}
+
+void Metrics::Observe(MetricHistogram histogram, uint64_t value)
+{
+    MetricsShard* shard = LMetricsShard.shard;
+    const size_t index = static_cast<size_t>(histogram);
+    const size_t bucket = std::min<size_t>(std::bit_width(value), BUCKET_COUNT - 1);
+
+    Increase(shard->buckets[index][bucket], 1);
+    Increase(shard->sums[index], value);
+}
+
+void Metrics::AddDisconnect(DisconnectReason reason)
+{
+    Increase(LMetricsShard.shard->disconnects[static_cast<size_t>(reason)], 1);
+}
+
+MetricsSnapshot Metrics::Snapshot()
+{
+    MetricsSnapshot snapshot;
+
+    MetricsRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    for (const std::unique_ptr<MetricsShard>& shard : registry.shards)
+        AddShard(snapshot, *shard);
+
+    return snapshot;
+}
+
+MetricsSnapshot Metrics::ThreadSnapshot()
+{
+    MetricsSnapshot snapshot;
+    AddShard(snapshot, *LMetricsShard.shard);
+    return snapshot;
+}
+
+/*-------------------
+    MetricsSnapshot
+--------------------*/
+std::string MetricsSnapshot::ToPrometheus() const
+{
+    std::string text;
+    char line[256];
+
+    for (size_t i = 0; i < COUNTER_COUNT; i++)
+    {
+        const char* name = CounterName(static_cast<MetricCounter>(i));
+        ::snprintf(line, sizeof(line), "# TYPE %s counter\n%s %llu\n", name, name,
+            static_cast<unsigned long long>(counters[i]));
+        text += line;
+    }
+
+    text += "# TYPE servercore_disconnects_total counter\n";
+    for (size_t i = 0; i < REASON_COUNT; i++)
+    {
+        ::snprintf(line, sizeof(line), "servercore_disconnects_total{reason=\"%s\"} %llu\n",
+            ToString(static_cast<DisconnectReason>(i)), static_cast<unsigned long long>(disconnects[i]));
+        text += line;
+    }
+
+    for (size_t h = 0; h < HISTOGRAM_COUNT; h++)
+    {
+        const char* name = HistogramName(static_cast<MetricHistogram>(h));
+        const Histogram& histogram = histograms[h];
+
+        ::snprintf(line, sizeof(line), "# TYPE %s histogram\n", name);
+        text += line;
+
+        // Ŷ b  2^b ̸  . Prometheus  le  踦 ϹǷ 2^b - 1   (Ŷ )
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b + 1 < BUCKET_COUNT; b++)
+        {
+            cumulative += histogram.buckets[b];
+            ::snprintf(line, sizeof(line), "%s_bucket{le=\"%llu\"} %llu\n", name,
+                static_cast<unsigned long long>((1ull << b) - 1), static_cast<unsigned long long>(cumulative));
+            text += line;
+        }
+
+        ::snprintf(line, sizeof(line), "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %llu\n%s_count %llu\n",
+            name, static_cast<unsigned long long>(histogram.count),
+            name, static_cast<unsigned long long>(histogram.sum),
+            name, static_cast<unsigned long long>(histogram.count));
+        text += line;
+    }
+
+    return text;
+}
+
+/*-------------------
+    MetricsExporter
+--------------------*/
+MetricsExporter::MetricsExporter(asio::io_context& ioc)
+    : _ioc(ioc)
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+    Stop();
+}
+
+bool MetricsExporter::StartHttp(const asio::ip::tcp::endpoint& endpoint)
+{
+    std::error_code ec;
+    _acceptor = std::make_unique<asio::ip::tcp::acceptor>(_ioc);
+    _acceptor->open(endpoint.protocol(), ec);
+    if (!ec) _acceptor->set_option(asio::socket_base::reuse_address(true), ec);
+    if (!ec) _acceptor->bind(endpoint, ec);
+    if (!ec) _acceptor->listen(asio::socket_base::max_listen_connections, ec);
+    if (ec)
+    {
+        _acceptor = nullptr;
+        return false;
+    }
+
+    _isRunning = true;
+    RegisterAccept();
+    return true;
+}
+
+void MetricsExporter::StartCallback(int32_t intervalMs, ExportCallback callback)
+{
+    _interval = std::chrono::milliseconds(intervalMs);
+    _callback = std::move(callback);
+    _timer = std::make_unique<asio::steady_timer>(_ioc);
+
+    _isRunning = true;
+    RegisterTimer();
+}
+
+void MetricsExporter::Stop()
+{
+    _isRunning = false;
+
+    std::error_code ec;
+    if (_acceptor)
+        _acceptor->close(ec);
+    if (_timer)
+        _timer->cancel();
+}
+
+void MetricsExporter::RegisterAccept()
+{
+    auto socket = std::make_shared<asio::ip::tcp::socket>(_ioc);
+    _acceptor->async_accept(*socket,
+        [self = shared_from_this(), socket](const std::error_code& error)
+        {
+            if (self->_isRunning == false)
+                return;
+
+            if (error)
+            {
+                // Listener   fd  ڶ   þ  ΰ ٽ Ǵ
+                self->_acceptBackoffMs = std::clamp(self->_acceptBackoffMs * 2, static_cast<int32_t>(ACCEPT_BACKOFF_MIN_MS), static_cast<int32_t>(ACCEPT_BACKOFF_MAX_MS));
+                TimerWheel::Get(self->_ioc).Schedule(std::chrono::milliseconds(self->_acceptBackoffMs), [self]()
+                    {
+                        if (self->_isRunning)
+                            self->RegisterAccept();
+                    });
+                return;
+            }
+
+            self->_acceptBackoffMs = 0;
+
+            // û   ʴ´.   а   ݴ´
+            auto request = std::make_shared<std::array<char, 1024>>();
+            socket->async_read_some(asio::buffer(*request),
+                [socket, request](const std::error_code& error, size_t bytesTransferred)
+                {
+                    if (error)
+                        return;
+
+                    const std::string body = Metrics::Snapshot().ToPrometheus();
+                    auto response = std::make_shared<std::string>(
+                        "HTTP/1.1 200 OK\r\n"
+                        "Content-Type: text/plain; version=0.0.4\r\n"
+                        "Connection: close\r\n"
+                        "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+
+                    asio::async_write(*socket, asio::buffer(*response),
+                        [socket, response](const std::error_code& error, size_t bytesTransferred)
+                        {
+                            std::error_code ec;
+                            socket->shutdown(asio::ip::tcp::socket::shutdown_both, ec);
+                            socket->close(ec);
+                        });
+                });
+
+            self->RegisterAccept();
+        });
+}
+
+void MetricsExporter::RegisterTimer()
+{
+    _timer->expires_after(_interval);
+    _timer->async_wait([self = shared_from_this()](const std::error_code& error)
+        {
+            if (error || self->_isRunning == false)
+                return;
+
+            self->_callback(Metrics::Snapshot().ToPrometheus());
+            self->RegisterTimer();
+        });
+}
@@ -0,0 +1,155 @@
+#pragma once
+#include "Session.h"
+#include "PacketReader.h"
+#include <type_traits>
+#include <cstring>
+
+/*-----------------
+    PacketHandler
+------------------*/
+// Ŷ id ϳ ó Լ  Ÿӿ ´
+//  - PacketT   Handler(SessionT&, const PacketT&)
+//    :     ۿ ״ д´ (    )
+//  - PacketT  void  Handler(SessionT&, BYTE* buffer, int32_t len)
+//    :   Ŷ,    ѱ
+//  - PacketT  PacketReader  Handler(SessionT&, PacketReader&)
+//    :  д PacketReader  ѱ.  Ѱ о ߸ Ŷ 
+template<uint16_t Id, typename PacketT, auto Handler>
+struct PacketHandler
+{
+    static constexpr uint16_t ID = Id;
+
+    template<typename SessionT>
+    static bool Handle(SessionT& session, BYTE* buffer, int32_t len)
+    {
+        if constexpr (std::is_void_v<PacketT>)
+        {
+            Handler(session, buffer, len);
+        }
+        else if constexpr (std::is_same_v<PacketT, PacketReader>)
+        {
+            PacketReader reader(buffer, len, sizeof(PacketHeader));
+            Handler(session, reader);
+            return reader.IsValid();
+        }
+        else
+        {
+            static_assert(std::is_trivially_copyable_v<PacketT>, "PacketT must be trivially copyable");
+
+            if (len < static_cast<int32_t>(sizeof(PacketHeader) + sizeof(PacketT)))
+                return false;
+
+            BYTE* body = buffer + sizeof(PacketHeader);
+            if constexpr (alignof(PacketT) > 1)
+            {
+                if (reinterpret_cast<uintptr_t>(body) % alignof(PacketT) != 0)
+                {
+                    alignas(PacketT) BYTE storage[sizeof(PacketT)];
+                    ::memcpy(storage, body, sizeof(PacketT));
+                    Handler(session, *reinterpret_cast<const PacketT*>(storage));
+                    return true;
+                }
+            }
+
+            Handler(session, *reinterpret_cast<const PacketT*>(body));
+        }
+
+        return true;
+    }
+};
+
+template<uint16_t Id, auto Handler>
+using RawPacketHandler = PacketHandler<Id, void, Handler>;
+
+template<uint16_t Id, auto Handler>
+using ReaderPacketHandler = PacketHandler<Id, PacketReader, Handler>;
+
+namespace PacketHandlerDetail
+{
+    enum : int32_t { TABLE_SIZE = 0x10000 };
+
+    template<typename SessionT>
+    using HandlerFunc = bool(*)(SessionT&, BYTE*, int32_t);
+
+    template<typename... Handlers>
+    constexpr bool HasUniqueIds()
+    {
+        constexpr uint16_t ids[] = { Handlers::ID..., 0 };
+        for (size_t i = 0; i < sizeof...(Handlers); i++)
+            for (size_t j = i + 1; j < sizeof...(Handlers); j++)
+                if (ids[i] == ids[j])
+                    return false;
+        return true;
+    }
+
+    template<typename SessionT, typename... Handlers>
+    constexpr std::array<HandlerFunc<SessionT>, TABLE_SIZE> MakeTable()
+    {
+        // ϵ id  ä.  nullptr (65536 ĭ    Ϸ constexpr  ѵ Ѵ´)
+        std::array<HandlerFunc<SessionT>, TABLE_SIZE> table{};
+        ((table[Handlers::ID] = &Handlers::template Handle<SessionT>), ...);
+        return table;
+    }
+}
+
+/*----------------------
+    PacketHandlerTable
+-----------------------*/
+// 65536  id ü   ̺  Ÿӿ 
+// ϵ  id  ̺ ȸ   ɷ (Dispatch  false)
+// COMPRESSED_PACKET_ID(0xFFFF)    ǿ  Ŷ  ǮǷ,   ص ȣ ʴ´
+template<typename SessionT, typename... Handlers>
+class PacketHandlerTable
+{
+    static_assert(PacketHandlerDetail::HasUniqueIds<Handlers...>(), "duplicate packet id");
+
+public:
+    static bool Dispatch(SessionT& session, const PacketView& packet)
+    {
+        PacketHandlerDetail::HandlerFunc<SessionT> func = Table[packet.id];
+        if (func == nullptr)
+            return false;
+
+        return func(session, packet.buffer, packet.size);
+    }
+
+    static constexpr bool IsRegistered(uint16_t id)
+    {
+        return Table[id] != nullptr;
+    }
+
+private:
+    static constexpr std::array<PacketHandlerDetail::HandlerFunc<SessionT>, PacketHandlerDetail::TABLE_SIZE> Table
+        = PacketHandlerDetail::MakeTable<SessionT, Handlers...>();
+};
+
+/*------------------------
+    PacketHandlerSession
+-------------------------*/
+//  Ŷ HandlerTable  ٷ 
+//  ȣ (OnRecvPackets)  ̰, Ŷٴ ̺ ȸ  ̴
+// ex) class GameSession : public PacketHandlerSession<GameSession, GameHandlers>
+template<typename SessionT, typename HandlerTable>
+class PacketHandlerSession : public PacketSession
+{
+public:
+    PacketHandlerSession(asio::io_context& ioc) : PacketSession(ioc) {}
+    virtual ~PacketHandlerSession() {}
+
+protected:
+    virtual void OnRecvPackets(std::span<const PacketView> packets) override
+    {
+        SessionT& session = static_cast<SessionT&>(*this);
+        for (const PacketView& packet : packets)
+        {
+            if (HandlerTable::Dispatch(session, packet) == false)
+            {
+                OnInvalidPacket(packet);
+                return;
+            }
+        }
+    }
+
+    // ϵ  id ̰ų  Ŷ ũ⺸ ª 
+    virtual void OnInvalidPacket(const PacketView& packet) { Disconnect(DisconnectReason::InvalidPacket); }
+};
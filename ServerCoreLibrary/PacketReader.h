@@ -0,0 +1,209 @@
+#pragma once
+#include "Session.h"
+#include <type_traits>
+#include <string_view>
+#include <bit>
+#include <cstring>
+
+namespace PacketSerializeDetail
+{
+    //  򰡿 memcpy    Ƿ Ʈ 迭 bit_cast Ѵ
+    template<typename T>
+    constexpr T Load(const BYTE* source)
+    {
+        if (std::is_constant_evaluated())
+        {
+            std::array<BYTE, sizeof(T)> bytes{};
+            for (size_t i = 0; i < sizeof(T); i++)
+                bytes[i] = source[i];
+            return std::bit_cast<T>(bytes);
+        }
+
+        T value;
+        ::memcpy(&value, source, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    constexpr void Store(BYTE* dest, const T& value)
+    {
+        if (std::is_constant_evaluated())
+        {
+            const std::array<BYTE, sizeof(T)> bytes = std::bit_cast<std::array<BYTE, sizeof(T)>>(value);
+            for (size_t i = 0; i < sizeof(T); i++)
+                dest[i] = bytes[i];
+            return;
+        }
+
+        ::memcpy(dest, &value, sizeof(T));
+    }
+}
+
+/*---------------
+    PacketArray
+----------------*/
+//    T 迭    
+//  ġ ĵ    Ƿ    
+template<typename T>
+class PacketArray
+{
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+    class Iterator
+    {
+    public:
+        constexpr Iterator(const BYTE* pos) : _pos(pos) {}
+
+        constexpr T         operator*() const { return PacketSerializeDetail::Load<T>(_pos); }
+        constexpr Iterator& operator++() { _pos += sizeof(T); return *this; }
+        constexpr bool      operator!=(const Iterator& other) const { return _pos != other._pos; }
+
+    private:
+        const BYTE* _pos;
+    };
+
+    constexpr PacketArray() = default;
+    constexpr PacketArray(const BYTE* buffer, uint16_t count) : _buffer(buffer), _count(count) {}
+
+    constexpr uint16_t  Count() const { return _count; }
+    constexpr bool      Empty() const { return _count == 0; }
+    constexpr T         operator[](uint16_t index) const { return PacketSerializeDetail::Load<T>(_buffer + index * sizeof(T)); }
+
+    constexpr Iterator  begin() const { return Iterator(_buffer); }
+    constexpr Iterator  end() const { return Iterator(_buffer + _count * sizeof(T)); }
+
+private:
+    const BYTE* _buffer = nullptr;
+    uint16_t    _count = 0;
+};
+
+/*----------------
+    PacketReader
+-----------------*/
+//  ۸   տ д´
+// -  Ѵ б ϰ,   ϸ  б⵵  Ѵ ( IsValid   ȴ)
+// - ڿ / 迭 uint16  ڿ Ұ ̾  (PacketWriter  )
+// - string_view / PacketArray   ۸ ŰǷ ڵ鷯 ȿ ȿϴ
+class PacketReader
+{
+public:
+    constexpr PacketReader() = default;
+    constexpr PacketReader(const BYTE* buffer, int32_t size, int32_t pos = 0)
+        : _buffer(buffer), _size(size), _pos(pos)
+    {
+        if (pos < 0 || pos > size)
+            _valid = false;
+    }
+
+    //    д´
+    explicit PacketReader(const PacketView& packet)
+        : PacketReader(packet.buffer, packet.size, sizeof(PacketHeader))
+    {
+    }
+
+    constexpr const BYTE*   Buffer() const { return _buffer; }
+    constexpr int32_t       Size() const { return _size; }
+    constexpr int32_t       ReadSize() const { return _pos; }
+    constexpr int32_t       RemainSize() const { return _size - _pos; }
+    constexpr bool          IsValid() const { return _valid; }
+
+    template<typename T>
+    constexpr bool Peek(T* dest) const
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+        if (_valid == false || RemainSize() < static_cast<int32_t>(sizeof(T)))
+            return false;
+
+        *dest = PacketSerializeDetail::Load<T>(_buffer + _pos);
+        return true;
+    }
+
+    template<typename T>
+    constexpr bool Read(T* dest)
+    {
+        if (Peek(dest) == false)
+            return Fail();
+
+        _pos += sizeof(T);
+        return true;
+    }
+
+    bool Read(void* dest, int32_t len)
+    {
+        const BYTE* source = ReadBytes(len);
+        if (source == nullptr)
+            return false;
+
+        ::memcpy(dest, source, len);
+        return true;
+    }
+
+    // len Ʈ ǳʶٰ   ġ ش ( )
+    constexpr const BYTE* ReadBytes(int32_t len)
+    {
+        if (_valid == false || len < 0 || RemainSize() < len)
+        {
+            Fail();
+            return nullptr;
+        }
+
+        const BYTE* source = _buffer + _pos;
+        _pos += len;
+        return source;
+    }
+
+    std::string_view ReadString()
+    {
+        uint16_t len = 0;
+        if (Read(&len) == false)
+            return {};
+
+        const BYTE* source = ReadBytes(len);
+        if (source == nullptr)
+            return {};
+
+        return std::string_view(reinterpret_cast<const char*>(source), len);
+    }
+
+    template<typename T>
+    constexpr PacketArray<T> ReadArray()
+    {
+        uint16_t count = 0;
+        if (Read(&count) == false)
+            return {};
+
+        const BYTE* source = ReadBytes(static_cast<int32_t>(count * sizeof(T)));
+        if (source == nullptr)
+            return {};
+
+        return PacketArray<T>(source, count);
+    }
+
+    template<typename T>
+    constexpr PacketReader& operator>>(T& dest)
+    {
+        Read(&dest);
+        return *this;
+    }
+
+    PacketReader& operator>>(std::string_view& dest)
+    {
+        dest = ReadString();
+        return *this;
+    }
+
+private:
+    constexpr bool Fail()
+    {
+        _valid = false;
+        return false;
+    }
+
+private:
+    const BYTE* _buffer = nullptr;
+    int32_t     _size = 0;
+    int32_t     _pos = 0;
+    bool        _valid = true;
+};
@@ -0,0 +1,222 @@
+#pragma once
+#include "PacketReader.h"
+#include "SendBuffer.h"
+
+/*----------------
+    BufferWriter
+-----------------*/
+// ۿ տ ȭѴ.  PacketReader   (  )
+// ۸ Ѵ  ϰ,   ϸ  ⵵  Ѵ
+class BufferWriter
+{
+public:
+    constexpr BufferWriter() = default;
+    constexpr BufferWriter(BYTE* buffer, int32_t size, int32_t pos = 0)
+        : _buffer(buffer), _size(size), _pos(pos)
+    {
+        if (pos < 0 || pos > size)
+            _valid = false;
+    }
+
+    constexpr BYTE*     Buffer() const { return _buffer; }
+    constexpr int32_t   Size() const { return _size; }
+    constexpr int32_t   WriteSize() const { return _pos; }
+    constexpr int32_t   FreeSize() const { return _size - _pos; }
+    constexpr bool      IsValid() const { return _valid; }
+
+    template<typename T>
+    constexpr bool Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        static_assert(std::is_pointer_v<T> == false, "use WriteString / Write(source, len) for pointers");
+        static_assert(std::is_convertible_v<const T&, std::string_view> == false, "use WriteString for strings");
+
+        BYTE* dest = Reserve(sizeof(T));
+        if (dest == nullptr)
+            return false;
+
+        PacketSerializeDetail::Store(dest, value);
+        return true;
+    }
+
+    bool Write(const void* source, int32_t len)
+    {
+        BYTE* dest = Reserve(len);
+        if (dest == nullptr)
+            return false;
+
+        ::memcpy(dest, source, len);
+        return true;
+    }
+
+    // [uint16 ][ڵ] (NUL , PacketReader::ReadString  д´)
+    constexpr bool WriteString(std::string_view value)
+    {
+        if (value.size() > UINT16_MAX)
+            return Fail();
+
+        if (Write(static_cast<uint16_t>(value.size())) == false)
+            return false;
+
+        BYTE* dest = Reserve(static_cast<int32_t>(value.size()));
+        if (dest == nullptr)
+            return false;
+
+        std::copy(value.begin(), value.end(), dest);
+        return true;
+    }
+
+    template<typename T>
+    bool WriteArray(std::span<const T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+        if (values.size() > UINT16_MAX)
+            return Fail();
+
+        return Write(static_cast<uint16_t>(values.size()))
+            && Write(values.data(), static_cast<int32_t>(values.size_bytes()));
+    }
+
+    // len Ʈ ڸ   ġ ش ( ä )
+    constexpr BYTE* Reserve(int32_t len)
+    {
+        if (_valid == false || len < 0 || FreeSize() < len)
+        {
+            Fail();
+            return nullptr;
+        }
+
+        BYTE* dest = _buffer + _pos;
+        _pos += len;
+        return dest;
+    }
+
+    // ڿ(ͷ, std::string, string_view) Ʒ string_view ε   η δ
+    template<typename T> requires (std::is_convertible_v<const T&, std::string_view> == false)
+    constexpr BufferWriter& operator<<(const T& value)
+    {
+        Write(value);
+        return *this;
+    }
+
+    constexpr BufferWriter& operator<<(std::string_view value)
+    {
+        WriteString(value);
+        return *this;
+    }
+
+protected:
+    constexpr bool Fail()
+    {
+        _valid = false;
+        return false;
+    }
+
+protected:
+    BYTE*       _buffer = nullptr;
+    int32_t     _size = 0;
+    int32_t     _pos = 0;
+    bool        _valid = true;
+};
+
+namespace PacketWriterDetail
+{
+    // ڿ ͷ / std::string  PacketReader::ReadString ( ) ̰ ״  ȮѴ
+    constexpr bool CheckStringRoundTrip()
+    {
+        BYTE buffer[32] = {};
+        BufferWriter writer(buffer, sizeof(buffer));
+        writer << "abc" << std::string("de") << static_cast<uint16_t>(7);
+        if (writer.IsValid() == false || writer.WriteSize() != 2 + 3 + 2 + 2 + 2)
+            return false;
+
+        PacketReader reader(buffer, writer.WriteSize());
+        uint16_t len = 0;
+        reader >> len;
+        const BYTE* abc = reader.ReadBytes(len);
+        if (len != 3 || abc == nullptr || abc[0] != 'a' || abc[2] != 'c')
+            return false;
+
+        reader >> len;
+        const BYTE* de = reader.ReadBytes(len);
+        uint16_t tail = 0;
+        reader >> tail;
+        return len == 2 && de != nullptr && de[1] == 'e' && tail == 7 && reader.IsValid() && reader.RemainSize() == 0;
+    }
+
+    static_assert(CheckStringRoundTrip(), "strings must be written with a uint16 length prefix");
+}
+
+/*----------------
+    PacketWriter
+-----------------*/
+// GSendBufferManager   SendBuffer   ڸ  ΰ ٷ 
+// Close()   ä SendBuffer  ݾ ֹǷ ߰   Send  ѱ ȴ
+// (Close  庰 ûũ  Ƿ  忡 ٸ SendBuffer    ȴ)
+//
+//  PacketWriter writer(PKT_S_CHAT);
+//  writer << playerId << message;
+//  session->Send(writer.Close());
+class PacketWriter : public BufferWriter
+{
+public:
+    enum : int32_t { MAX_PACKET_SIZE = 0xFFFF };    // PacketHeader::size  uint16
+
+    // reserveSize    ִ ũ.  ŭ Close  ûũ ش
+    explicit PacketWriter(uint16_t packetId, int32_t reserveSize = 0x400)
+        : _packetId(packetId)
+    {
+        reserveSize = std::clamp<int32_t>(reserveSize, sizeof(PacketHeader), MAX_PACKET_SIZE);
+
+        _sendBuffer = GSendBufferManager->Open(reserveSize);
+        _buffer = _sendBuffer->Buffer();
+        _size = reserveSize;
+        _pos = sizeof(PacketHeader);
+    }
+
+    PacketWriter(const PacketWriter&) = delete;
+    PacketWriter& operator=(const PacketWriter&) = delete;
+
+    ~PacketWriter()
+    {
+        // Close  ʾ  ûũ ݾ д
+        if (_sendBuffer)
+            _sendBuffer->Close(0);
+    }
+
+    template<typename T>
+    PacketWriter& operator<<(const T& value)
+    {
+        BufferWriter::operator<<(value);
+        return *this;
+    }
+
+    PacketWriter& operator<<(std::string_view value)
+    {
+        BufferWriter::operator<<(value);
+        return *this;
+    }
+
+    //  ä ݴ´.   nullptr (ûũ ݾƼ ش)
+    std::shared_ptr<SendBuffer> Close()
+    {
+        if (_sendBuffer == nullptr)
+            return nullptr;
+
+        std::shared_ptr<SendBuffer> sendBuffer = std::move(_sendBuffer);
+        if (_valid == false)
+        {
+            sendBuffer->Close(0);
+            return nullptr;
+        }
+
+        PacketSerializeDetail::Store(_buffer, PacketHeader{ static_cast<uint16_t>(_pos), _packetId });
+        sendBuffer->Close(_pos);
+        return sendBuffer;
+    }
+
+private:
+    uint16_t                    _packetId = 0;
+    std::shared_ptr<SendBuffer> _sendBuffer;
+};
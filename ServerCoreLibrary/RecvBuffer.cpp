@@ -1,10 +1,146 @@
 #include "pch.h"
 #include "RecvBuffer.h"
+#include "Metrics.h"
 
-RecvBuffer::RecvBuffer(int32_t bufferSize) : _bufferSize(bufferSize)
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+RecvBuffer::RecvBuffer(int32_t capacity)
+{
+    Init(capacity);
+}
+
+RecvBuffer::~RecvBuffer()
+{
+    Release();
+}
+
+bool RecvBuffer::Init(int32_t capacity)
+{
+    // Ͱ   ٲ  
+    if (DataSize() > 0 || capacity <= 0)
+        return false;
+
+    Release();
+
+    //   ø
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    const int32_t granularity = static_cast<int32_t>(info.dwAllocationGranularity);
+#else
+    const int32_t granularity = static_cast<int32_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    capacity = (capacity + granularity - 1) / granularity * granularity;
+
+    if (MapMirror(capacity))
+    {
+        _mirrored = true;
+    }
+    else
+    {
+        _fallback.resize(capacity);
+        _buffer = _fallback.data();
+        _mirrored = false;
+    }
+
+    _capacity = capacity;
+    _readPos = _writePos = 0;
+    return true;
+}
+
+bool RecvBuffer::MapMirror(int32_t capacity)
+{
+#if defined(_WIN32)
+    HANDLE mapping = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, capacity, nullptr);
+    if (mapping == nullptr)
+        return false;
+
+    //  ּ  ã   ڸ   Ѵ.   ٸ 尡  õ
+    BYTE* mirror = nullptr;
+    for (int32_t retry = 0; retry < 8 && mirror == nullptr; retry++)
+    {
+        void* base = ::VirtualAlloc(nullptr, static_cast<SIZE_T>(capacity) * 2, MEM_RESERVE, PAGE_NOACCESS);
+        if (base == nullptr)
+            break;
+        ::VirtualFree(base, 0, MEM_RELEASE);
+
+        BYTE* first = static_cast<BYTE*>(::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, base));
+        BYTE* second = static_cast<BYTE*>(::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, static_cast<BYTE*>(base) + capacity));
+        if (first == base && second == static_cast<BYTE*>(base) + capacity)
+        {
+            mirror = first;
+            break;
+        }
+
+        if (first)
+            ::UnmapViewOfFile(first);
+        if (second)
+            ::UnmapViewOfFile(second);
+    }
+
+    // ε 䰡   Ƿ ڵ ٷ ݴ´
+    ::CloseHandle(mapping);
+
+    _buffer = mirror;
+    return mirror != nullptr;
+#elif defined(__linux__)
+    int fd = ::memfd_create("RecvBuffer", MFD_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    if (::ftruncate(fd, capacity) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // ּ  2踦  ΰ  fd  յڷ  Ѵ
+    void* base = ::mmap(nullptr, static_cast<size_t>(capacity) * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    BYTE* first = static_cast<BYTE*>(base);
+    bool mapped = ::mmap(first, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+        && ::mmap(first + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    ::close(fd);
+
+    if (!mapped)
+    {
+        ::munmap(base, static_cast<size_t>(capacity) * 2);
+        return false;
+    }
+
+    _buffer = first;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RecvBuffer::Release()
 {
-    _capacity = bufferSize * BUFFER_COUNT;
-    _buffer.resize(_capacity);
+    if (_mirrored && _buffer)
+    {
+#if defined(_WIN32)
+        ::UnmapViewOfFile(_buffer);
+        ::UnmapViewOfFile(_buffer + _capacity);
+#elif defined(__linux__)
+        ::munmap(_buffer, static_cast<size_t>(_capacity) * 2);
+#endif
+    }
+
+    _fallback.clear();
+    _fallback.shrink_to_fit();
+    _buffer = nullptr;
+    _capacity = 0;
+    _mirrored = false;
+    _readPos = _writePos = 0;
 }
 
 void RecvBuffer::Clean()
@@ -14,11 +150,13 @@ void RecvBuffer::Clean()
     {
         _readPos = _writePos = 0;
     }
-    else
+    else if (_mirrored == false)
     {
-        if (FreeSize() < _bufferSize)
+        //      
+        if (FreeSize() < _capacity / 2)
         {
-            ::memcpy(&_buffer[0], &_buffer[_readPos], dataSize);
+            ::memmove(&_buffer[0], &_buffer[_readPos], dataSize);
+            Metrics::Add(MetricCounter::RecvBufferMoveBytes, dataSize);
             _readPos = 0;
             _writePos = dataSize;
         }
@@ -31,6 +169,13 @@ bool RecvBuffer::OnRead(int32_t numOfBytes)
         return false;
 
     _readPos += numOfBytes;
+
+    // б ġ   Ѿ  ǥ ǵ ( ޸)
+    if (_mirrored && _readPos >= _capacity)
+    {
+        _readPos -= _capacity;
+        _writePos -= _capacity;
+    }
     return true;
 }
 
@@ -41,4 +186,36 @@ bool RecvBuffer::OnWrite(int32_t numOfBytes)
 
     _writePos += numOfBytes;
     return true;
-}
\ No newline at end of file
+}
+
+/*------------------
+    RecvBufferPool
+-------------------*/
+thread_local std::vector<std::unique_ptr<RecvBuffer>> LRecvBufferPool;
+
+std::unique_ptr<RecvBuffer> RecvBufferPool::Pop(int32_t capacity)
+{
+    for (auto it = LRecvBufferPool.rbegin(); it != LRecvBufferPool.rend(); ++it)
+    {
+        if ((*it)->Capacity() >= capacity)
+        {
+            std::unique_ptr<RecvBuffer> buffer = std::move(*it);
+            LRecvBufferPool.erase(std::next(it).base());
+            return buffer;
+        }
+    }
+
+    return std::make_unique<RecvBuffer>(capacity);
+}
+
+void RecvBufferPool::Push(std::unique_ptr<RecvBuffer> buffer)
+{
+    if (buffer == nullptr || buffer->DataSize() > 0)
+        return;
+
+    if (LRecvBufferPool.size() >= MAX_POOLED_BUFFERS)
+        return;
+
+    buffer->Clean();
+    LRecvBufferPool.push_back(std::move(buffer));
+}
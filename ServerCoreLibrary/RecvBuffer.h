@@ -1,13 +1,25 @@
 #pragma once
 
+/*----------------
+    RecvBuffer
+-----------------*/
+//     ּҿ   ޾   
+// [ 0 ~ capacity )  [ capacity ~ 2 * capacity )   ޸𸮶,
+//  Ѿ Ŷ (Clean)  ӵ ޸𸮷   ִ.
+// - ũ  (Windows  Ҵ  64KB) øѴ
+// - Ǹ  2 Ƿ    vm.max_map_count  ÷ Ѵ
+// -  ο ϸ Ϲ  +   (memmove) Ѵ
 class RecvBuffer
 {
-    enum { BUFFER_COUNT = 10 };
-
 public:
-    RecvBuffer(int32_t bufferSize);
-    ~RecvBuffer() = default;
+    RecvBuffer() = default;
+    RecvBuffer(int32_t capacity);
+    ~RecvBuffer();
+
+    RecvBuffer(const RecvBuffer&) = delete;
+    RecvBuffer& operator=(const RecvBuffer&) = delete;
 
+    bool            Init(int32_t capacity);
     void            Clean();
     bool            OnRead(int32_t numOfBytes);
     bool            OnWrite(int32_t numOfBytes);
@@ -15,14 +27,35 @@ public:
     BYTE* ReadPos() { return &_buffer[_readPos]; }
     BYTE* WritePos() { return &_buffer[_writePos]; }
     int32_t         DataSize() const { return _writePos - _readPos; }
-    int32_t         FreeSize() const { return _capacity - _writePos; }
+    int32_t         FreeSize() const { return _mirrored ? _capacity - DataSize() : _capacity - _writePos; }
+    int32_t         Capacity() const { return _capacity; }
+    bool            IsMirrored() const { return _mirrored; }
+
+private:
+    bool            MapMirror(int32_t capacity);
+    void            Release();
 
 private:
+    BYTE*           _buffer = nullptr;
     int32_t         _capacity = 0;
-    int32_t         _bufferSize = 0;
     int32_t         _readPos = 0;
     int32_t         _writePos = 0;
-    std::vector<BYTE> _buffer;
+    bool            _mirrored = false;
+    std::vector<BYTE> _fallback;
+};
+
+/*------------------
+    RecvBufferPool
+-------------------*/
+//   忡  庰   Ǯ ( )
+//   ִ 尡 ޶ Ǹ, ġ ۴ Ѵ.
+class RecvBufferPool
+{
+    enum { MAX_POOLED_BUFFERS = 32 };
+
+public:
+    static std::unique_ptr<RecvBuffer> Pop(int32_t capacity);
+    static void                        Push(std::unique_ptr<RecvBuffer> buffer);
 };
 
 ================================================================================
@@ -31,11 +64,147 @@ private:
 
 #include "pch.h"
 #include "RecvBuffer.h"
+#include "Metrics.h"
 
-RecvBuffer::RecvBuffer(int32_t bufferSize) : _bufferSize(bufferSize)
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+RecvBuffer::RecvBuffer(int32_t capacity)
 {
-    _capacity = bufferSize * BUFFER_COUNT;
-    _buffer.resize(_capacity);
+    Init(capacity);
+}
+
+RecvBuffer::~RecvBuffer()
+{
+    Release();
+}
+
+bool RecvBuffer::Init(int32_t capacity)
+{
+    // Ͱ   ٲ  
+    if (DataSize() > 0 || capacity <= 0)
+        return false;
+
+    Release();
+
+    //   ø
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    const int32_t granularity = static_cast<int32_t>(info.dwAllocationGranularity);
+#else
+    const int32_t granularity = static_cast<int32_t>(::sysconf(_SC_PAGESIZE));
+#endif
+    capacity = (capacity + granularity - 1) / granularity * granularity;
+
+    if (MapMirror(capacity))
+    {
+        _mirrored = true;
+    }
+    else
+    {
+        _fallback.resize(capacity);
+        _buffer = _fallback.data();
+        _mirrored = false;
+    }
+
+    _capacity = capacity;
+    _readPos = _writePos = 0;
+    return true;
+}
+
+bool RecvBuffer::MapMirror(int32_t capacity)
+{
+#if defined(_WIN32)
+    HANDLE mapping = ::CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, capacity, nullptr);
+    if (mapping == nullptr)
+        return false;
+
+    //  ּ  ã   ڸ   Ѵ.   ٸ 尡  õ
+    BYTE* mirror = nullptr;
+    for (int32_t retry = 0; retry < 8 && mirror == nullptr; retry++)
+    {
+        void* base = ::VirtualAlloc(nullptr, static_cast<SIZE_T>(capacity) * 2, MEM_RESERVE, PAGE_NOACCESS);
+        if (base == nullptr)
+            break;
+        ::VirtualFree(base, 0, MEM_RELEASE);
+
+        BYTE* first = static_cast<BYTE*>(::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, base));
+        BYTE* second = static_cast<BYTE*>(::MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, static_cast<BYTE*>(base) + capacity));
+        if (first == base && second == static_cast<BYTE*>(base) + capacity)
+        {
+            mirror = first;
+            break;
+        }
+
+        if (first)
+            ::UnmapViewOfFile(first);
+        if (second)
+            ::UnmapViewOfFile(second);
+    }
+
+    // ε 䰡   Ƿ ڵ ٷ ݴ´
+    ::CloseHandle(mapping);
+
+    _buffer = mirror;
+    return mirror != nullptr;
+#elif defined(__linux__)
+    int fd = ::memfd_create("RecvBuffer", MFD_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    if (::ftruncate(fd, capacity) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // ּ  2踦  ΰ  fd  յڷ  Ѵ
+    void* base = ::mmap(nullptr, static_cast<size_t>(capacity) * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    BYTE* first = static_cast<BYTE*>(base);
+    bool mapped = ::mmap(first, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED
+        && ::mmap(first + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED;
+    ::close(fd);
+
+    if (!mapped)
+    {
+        ::munmap(base, static_cast<size_t>(capacity) * 2);
+        return false;
+    }
+
+    _buffer = first;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RecvBuffer::Release()
+{
+    if (_mirrored && _buffer)
+    {
+#if defined(_WIN32)
+        ::UnmapViewOfFile(_buffer);
+        ::UnmapViewOfFile(_buffer + _capacity);
+#elif defined(__linux__)
+        ::munmap(_buffer, static_cast<size_t>(_capacity) * 2);
+#endif
+    }
+
+    _fallback.clear();
+    _fallback.shrink_to_fit();
+    _buffer = nullptr;
+    _capacity = 0;
+    _mirrored = false;
+    _readPos = _writePos = 0;
 }
 
 void RecvBuffer::Clean()
@@ -45,11 +214,13 @@ void RecvBuffer::Clean()
     {
         _readPos = _writePos = 0;
     }
-    else
+    else if (_mirrored == false)
     {
-        if (FreeSize() < _bufferSize)
+        //      
+        if (FreeSize() < _capacity / 2)
         {
-            ::memcpy(&_buffer[0], &_buffer[_readPos], dataSize);
+            ::memmove(&_buffer[0], &_buffer[_readPos], dataSize);
+            Metrics::Add(MetricCounter::RecvBufferMoveBytes, dataSize);
             _readPos = 0;
             _writePos = dataSize;
         }
@@ -62,6 +233,13 @@ bool RecvBuffer::OnRead(int32_t numOfBytes)
         return false;
 
     _readPos += numOfBytes;
+
+    // б ġ   Ѿ  ǥ ǵ ( ޸)
+    if (_mirrored && _readPos >= _capacity)
+    {
+        _readPos -= _capacity;
+        _writePos -= _capacity;
+    }
     return true;
 }
 
@@ -72,4 +250,36 @@ bool RecvBuffer::OnWrite(int32_t numOfBytes)
 
     _writePos += numOfBytes;
     return true;
-}
\ No newline at end of file
+}
+
+/*------------------
+    RecvBufferPool
+-------------------*/
+thread_local std::vector<std::unique_ptr<RecvBuffer>> LRecvBufferPool;
+
+std::unique_ptr<RecvBuffer> RecvBufferPool::Pop(int32_t capacity)
+{
+    for (auto it = LRecvBufferPool.rbegin(); it != LRecvBufferPool.rend(); ++it)
+    {
+        if ((*it)->Capacity() >= capacity)
+        {
+            std::unique_ptr<RecvBuffer> buffer = std::move(*it);
+            LRecvBufferPool.erase(std::next(it).base());
+            return buffer;
+        }
+    }
+
+    return std::make_unique<RecvBuffer>(capacity);
+}
+
+void RecvBufferPool::Push(std::unique_ptr<RecvBuffer> buffer)
+{
+    if (buffer == nullptr || buffer->DataSize() > 0)
+        return;
+
+    if (LRecvBufferPool.size() >= MAX_POOLED_BUFFERS)
+        return;
+
+    buffer->Clean();
+    LRecvBufferPool.push_back(std::move(buffer));
+}
@@ -1,6 +1,90 @@
 #include "pch.h"
 #include "SendBuffer.h"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+/*-------------------------
+    SendBufferBlockAllocator
+--------------------------*/
+thread_local bool LSendBufferBlockCacheDestroyed = false;
+
+// shared_ptr    ĳ (SendBuffer  Ŷ, ûũ ڵ Pop  )
+// 庰̶  ʿ . BLOCK_SIZE  ū û ״  
+struct SendBufferBlockCache
+{
+    enum { BLOCK_SIZE = 128, MAX_CACHED_BLOCKS = 1024 };
+
+    ~SendBufferBlockCache()
+    {
+        //  ݳǴ  ٷ Ѵ
+        LSendBufferBlockCacheDestroyed = true;
+        for (void* block : blocks)
+            ::operator delete(block);
+    }
+
+    void* Alloc()
+    {
+        if (blocks.empty())
+            return ::operator new(BLOCK_SIZE);
+
+        void* block = blocks.back();
+        blocks.pop_back();
+        return block;
+    }
+
+    void Free(void* block)
+    {
+        if (blocks.size() >= MAX_CACHED_BLOCKS)
+        {
+            ::operator delete(block);
+            return;
+        }
+        blocks.push_back(block);
+    }
+
+    std::vector<void*> blocks;
+};
+
+thread_local SendBufferBlockCache LSendBufferBlockCache;
+
+template<typename T>
+struct SendBufferBlockAllocator
+{
+    using value_type = T;
+
+    SendBufferBlockAllocator() = default;
+    template<typename U>
+    SendBufferBlockAllocator(const SendBufferBlockAllocator<U>&) {}
+
+    T* allocate(size_t count)
+    {
+        const size_t size = count * sizeof(T);
+        if (size > SendBufferBlockCache::BLOCK_SIZE || LSendBufferBlockCacheDestroyed)
+            return static_cast<T*>(::operator new(size));
+        return static_cast<T*>(LSendBufferBlockCache.Alloc());
+    }
+
+    void deallocate(T* pointer, size_t count)
+    {
+        if (count * sizeof(T) > SendBufferBlockCache::BLOCK_SIZE || LSendBufferBlockCacheDestroyed)
+        {
+            ::operator delete(pointer);
+            return;
+        }
+        LSendBufferBlockCache.Free(pointer);
+    }
+
+    template<typename U>
+    bool operator==(const SendBufferBlockAllocator<U>&) const { return true; }
+    template<typename U>
+    bool operator!=(const SendBufferBlockAllocator<U>&) const { return false; }
+};
+
+/*----------------
+    SendBuffer
+-----------------*/
 SendBuffer::SendBuffer(std::shared_ptr<SendBufferChunk> owner, BYTE* buffer, uint32_t allocSize)
     : _owner(owner), _buffer(buffer), _allocSize(allocSize)
 {
@@ -16,9 +100,9 @@ void SendBuffer::Close(uint32_t writeSize)
 /*--------------------
     SendBufferChunk
 --------------------*/
-SendBufferChunk::SendBufferChunk()
+SendBufferChunk::SendBufferChunk(BYTE* buffer, uint32_t capacity, int32_t sizeClass)
+    : _buffer(buffer), _capacity(capacity), _sizeClass(sizeClass)
 {
-    _buffer.resize(SEND_BUFFER_CHUNK_SIZE);
 }
 
 void SendBufferChunk::Reset()
@@ -29,14 +113,14 @@ void SendBufferChunk::Reset()
 
 std::shared_ptr<SendBuffer> SendBufferChunk::Open(uint32_t allocSize)
 {
-    assert(allocSize <= SEND_BUFFER_CHUNK_SIZE);
+    assert(allocSize <= _capacity);
     assert(_open == false);
 
     if (allocSize > FreeSize())
         return nullptr;
 
     _open = true;
-    return std::make_shared<SendBuffer>(shared_from_this(), Buffer(), allocSize);
+    return std::allocate_shared<SendBuffer>(SendBufferBlockAllocator<SendBuffer>(), shared_from_this(), Buffer(), allocSize);
 }
 
 void SendBufferChunk::Close(uint32_t writeSize)
@@ -46,51 +130,414 @@ void SendBufferChunk::Close(uint32_t writeSize)
     _usedSize += writeSize;
 }
 
+void SendBufferChunk::Decommit()
+{
+    // ּ  ϰ  ޸𸮸 ش
+#ifdef _WIN32
+    ::VirtualFree(_buffer, _capacity, MEM_DECOMMIT);
+#else
+    ::madvise(_buffer, _capacity, MADV_DONTNEED);
+#endif
+}
+
+void SendBufferChunk::Commit()
+{
+#ifdef _WIN32
+    if (::VirtualAlloc(_buffer, _capacity, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+        throw std::bad_alloc();
+#endif
+}
+
 /*---------------------
     SendBufferManager
 ----------------------*/
-thread_local std::shared_ptr<SendBufferChunk> LSendBufferChunk;
+// 庰 ûũ ĳ ( )
+struct SendBufferChunkCache
+{
+    ~SendBufferChunkCache();
+
+    std::shared_ptr<SendBufferChunk> current[SendBufferManager::SIZE_CLASS_COUNT];
+    std::shared_ptr<SendBufferChunk> detached[SendBufferManager::SIZE_CLASS_COUNT];   // OpenDetached 
+    std::vector<SendBufferChunk*>    chunks[SendBufferManager::SIZE_CLASS_COUNT];
+};
+
+thread_local SendBufferChunkCache LSendBufferChunkCache;
+thread_local bool LSendBufferChunkCacheDestroyed = false;
+
+SendBufferChunkCache::~SendBufferChunkCache()
+{
+    //  ݳǴ ûũ ٷ  
+    LSendBufferChunkCacheDestroyed = true;
+
+    for (int32_t i = 0; i < SendBufferManager::SIZE_CLASS_COUNT; i++)
+    {
+        current[i] = nullptr;
+        detached[i] = nullptr;
+        if (GSendBufferManager && chunks[i].empty() == false)
+            GSendBufferManager->Push(chunks[i], chunks[i].size());
+    }
+}
+
+SendBufferManager::SendBufferManager()
+{
+    for (int32_t i = 0; i < SIZE_CLASS_COUNT; i++)
+        _pools[i].highWaterMark = HIGH_WATER_MARK[i];
+}
+
+SendBufferManager::~SendBufferManager()
+{
+    _chunks.clear();
+
+    for (auto& [arena, size] : _arenas)
+    {
+#ifdef _WIN32
+        ::VirtualFree(arena, 0, MEM_RELEASE);
+#else
+        ::munmap(arena, size);
+#endif
+    }
+}
+
+int32_t SendBufferManager::GetSizeClass(uint32_t size)
+{
+    for (int32_t i = 0; i < SIZE_CLASS_COUNT; i++)
+    {
+        if (size <= CHUNK_SIZE[i])
+            return i;
+    }
+    return -1;
+}
 
 std::shared_ptr<SendBuffer> SendBufferManager::Open(uint32_t size)
 {
-    if (LSendBufferChunk == nullptr)
+    int32_t sizeClass = GetSizeClass(size);
+    assert(sizeClass >= 0);
+    if (sizeClass < 0)
+        return nullptr;
+
+    return Open(LSendBufferChunkCache.current[sizeClass], sizeClass, size);
+}
+
+std::shared_ptr<SendBuffer> SendBufferManager::OpenDetached(uint32_t size)
+{
+    int32_t sizeClass = GetSizeClass(size);
+    assert(sizeClass >= 0);
+    if (sizeClass < 0)
+        return nullptr;
+
+    return Open(LSendBufferChunkCache.detached[sizeClass], sizeClass, size);
+}
+
+std::shared_ptr<SendBuffer> SendBufferManager::Open(std::shared_ptr<SendBufferChunk>& chunk, int32_t sizeClass, uint32_t size)
+{
+    if (chunk == nullptr)
+        chunk = Pop(sizeClass);
+
+    assert(chunk->IsOpen() == false);
+
+    if (chunk->FreeSize() < size)
+        chunk = Pop(sizeClass);
+
+    return chunk->Open(size);
+}
+
+std::vector<std::shared_ptr<SendBuffer>> SendBufferManager::OpenLarge(uint32_t size)
+{
+    std::vector<std::shared_ptr<SendBuffer>> sendBuffers;
+    sendBuffers.reserve((size + MAX_CHUNK_SIZE - 1) / MAX_CHUNK_SIZE);
+
+    while (size > 0)
+    {
+        //   ûũ ޴´ (庰  ûũ ǵ帮 ʴ´)
+        uint32_t allocSize = std::min<uint32_t>(size, MAX_CHUNK_SIZE);
+        sendBuffers.push_back(Pop(GetSizeClass(allocSize))->Open(allocSize));
+        size -= allocSize;
+    }
+
+    return sendBuffers;
+}
+
+SendBufferPoolStats SendBufferManager::GetStats(int32_t sizeClass) const
+{
+    const Pool& pool = _pools[sizeClass];
+
+    SendBufferPoolStats stats;
+    stats.localHits = pool.localHits.load(std::memory_order_relaxed);
+    stats.globalHits = pool.globalHits.load(std::memory_order_relaxed);
+    stats.arenaAllocs = pool.arenaAllocs.load(std::memory_order_relaxed);
+    stats.liveChunks = pool.liveChunks.load(std::memory_order_relaxed);
+    stats.trimmedChunks = pool.cold.Count();
+    stats.pooledChunks = pool.hot.Count() + stats.trimmedChunks;
+    stats.totalChunks = pool.totalChunks.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::shared_ptr<SendBufferChunk> SendBufferManager::Pop(int32_t sizeClass)
+{
+    Pool& pool = _pools[sizeClass];
+    std::vector<SendBufferChunk*>& cache = LSendBufferChunkCache.chunks[sizeClass];
+
+    if (cache.empty())
+    {
+        // ĳ ݸŭ   ä д
+        const int32_t batch = std::max(1, LOCAL_CACHE_SIZE[sizeClass] / 2);
+
+        SendBufferChunk* chunk = PopStack(sizeClass);
+        if (chunk)
+        {
+            pool.globalHits.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            AllocArena(sizeClass);
+            pool.arenaAllocs.fetch_add(1, std::memory_order_relaxed);
+            chunk = PopStack(sizeClass);
+        }
+
+        while (chunk)
+        {
+            cache.push_back(chunk);
+            if (static_cast<int32_t>(cache.size()) >= batch)
+                break;
+            chunk = PopStack(sizeClass);
+        }
+    }
+    else
     {
-        LSendBufferChunk = Pop();
-        LSendBufferChunk->Reset();
+        pool.localHits.fetch_add(1, std::memory_order_relaxed);
     }
 
-    assert(LSendBufferChunk->IsOpen() == false);
+    // ٸ 尡 Ʒ   
+    if (cache.empty())
+        return Pop(sizeClass);
+
+    SendBufferChunk* chunk = cache.back();
+    cache.pop_back();
+    chunk->Reset();
+
+    pool.liveChunks.fetch_add(1, std::memory_order_relaxed);
+    return std::shared_ptr<SendBufferChunk>(chunk, PushGlobal, SendBufferBlockAllocator<SendBufferChunk>());
+}
+
+SendBufferChunk* SendBufferManager::PopStack(int32_t sizeClass)
+{
+    Pool& pool = _pools[sizeClass];
 
-    if (LSendBufferChunk->FreeSize() < size)
+    if (LockFreeStackNode* node = pool.hot.Pop())
+        return static_cast<SendBufferChunk*>(node);
+
+    if (LockFreeStackNode* node = pool.cold.Pop())
     {
-        LSendBufferChunk = Pop();
-        LSendBufferChunk->Reset();
+        SendBufferChunk* chunk = static_cast<SendBufferChunk*>(node);
+        chunk->Commit();
+        return chunk;
     }
 
-    return LSendBufferChunk->Open(size);
+    return nullptr;
 }
 
-std::shared_ptr<SendBufferChunk> SendBufferManager::Pop()
+void SendBufferManager::Push(SendBufferChunk* chunk)
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    Pool& pool = _pools[chunk->SizeClass()];
 
-    if (!_sendBufferChunks.empty())
+    // highWaterMark  Ѵ ŭ  ޸𸮸 ݳ д
+    if (pool.hot.Count() < pool.highWaterMark)
     {
-        std::shared_ptr<SendBufferChunk> sendBufferChunk = _sendBufferChunks.back();
-        _sendBufferChunks.pop_back();
-        return sendBufferChunk;
+        pool.hot.Push(chunk);
     }
+    else
+    {
+        chunk->Decommit();
+        pool.cold.Push(chunk);
+    }
+}
 
-    return std::make_shared<SendBufferChunk>();
+void SendBufferManager::Push(std::vector<SendBufferChunk*>& chunks, size_t count)
+{
+    for (size_t i = chunks.size() - count; i < chunks.size(); i++)
+        Push(chunks[i]);
+    chunks.resize(chunks.size() - count);
 }
 
-void SendBufferManager::Push(std::shared_ptr<SendBufferChunk> buffer)
+void SendBufferManager::AllocArena(int32_t sizeClass)
 {
     std::lock_guard<std::mutex> lock(_lock);
-    _sendBufferChunks.push_back(buffer);
+
+    Pool& pool = _pools[sizeClass];
+
+    //  ٸ  ٸ 尡 ̹ ä
+    if (pool.hot.Count() > 0)
+        return;
+
+    const size_t arenaSize = ARENA_SIZE[sizeClass];
+    const uint32_t chunkSize = CHUNK_SIZE[sizeClass];
+
+#ifdef _WIN32
+    BYTE* arena = static_cast<BYTE*>(::VirtualAlloc(nullptr, arenaSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+    void* memory = ::mmap(nullptr, arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    BYTE* arena = (memory == MAP_FAILED) ? nullptr : static_cast<BYTE*>(memory);
+#endif
+    if (arena == nullptr)
+        throw std::bad_alloc();
+
+    _arenas.push_back({ arena, arenaSize });
+
+    for (size_t offset = 0; offset + chunkSize <= arenaSize; offset += chunkSize)
+    {
+        _chunks.push_back(std::make_unique<SendBufferChunk>(arena + offset, chunkSize, sizeClass));
+        pool.hot.Push(_chunks.back().get());
+        pool.totalChunks.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void SendBufferManager::PushGlobal(SendBufferChunk* buffer)
 {
-    GSendBufferManager->Push(std::shared_ptr<SendBufferChunk>(buffer, PushGlobal));
-}
\ No newline at end of file
+    // shared_ptr<SendBufferChunk>  . ݳ  ĳ÷  ش
+    GSendBufferManager->_pools[buffer->SizeClass()].liveChunks.fetch_sub(1, std::memory_order_relaxed);
+
+    if (LSendBufferChunkCacheDestroyed)
+    {
+        GSendBufferManager->Push(buffer);
+        return;
+    }
+
+    const int32_t sizeClass = buffer->SizeClass();
+    std::vector<SendBufferChunk*>& cache = LSendBufferChunkCache.chunks[sizeClass];
+    cache.push_back(buffer);
+
+    // ġ   
+    if (cache.size() > static_cast<size_t>(LOCAL_CACHE_SIZE[sizeClass]))
+        GSendBufferManager->Push(cache, cache.size() / 2);
+}
+
+/*----------------
+    SendQueue
+-----------------*/
+struct SendNode : public MpscNode
+{
+    std::shared_ptr<SendBuffer> buffer;
+};
+
+//   ĳ (庰̶  ʿ )
+struct SendNodeCache
+{
+    enum { MAX_CACHED_NODES = 1024 };
+
+    ~SendNodeCache()
+    {
+        for (SendNode* node : nodes)
+            delete node;
+    }
+
+    SendNode* Alloc()
+    {
+        if (nodes.empty())
+            return new SendNode();
+
+        SendNode* node = nodes.back();
+        nodes.pop_back();
+        return node;
+    }
+
+    void Free(SendNode* node)
+    {
+        if (nodes.size() >= MAX_CACHED_NODES)
+        {
+            delete node;
+            return;
+        }
+        nodes.push_back(node);
+    }
+
+    std::vector<SendNode*> nodes;
+};
+
+thread_local SendNodeCache LSendNodeCache;
+
+SendQueue::~SendQueue()
+{
+    while (Pop() != nullptr) {}
+}
+
+bool SendQueue::Push(std::shared_ptr<SendBuffer> sendBuffer)
+{
+    SendNode* node = LSendNodeCache.Alloc();
+    node->buffer = std::move(sendBuffer);
+
+    //   ÷ Һڰ    _count   ʴ´
+    const int32_t prevCount = _count.fetch_add(1, std::memory_order_acq_rel);
+    _queue.Push(node);
+
+    // ť  ־ٸ ȣ  ۽ Ѵ
+    return prevCount == 0 || Unpark();
+}
+
+bool SendQueue::Push(std::span<const std::shared_ptr<SendBuffer>> sendBuffers)
+{
+    if (sendBuffers.empty())
+        return false;
+
+    SendNode* first = nullptr;
+    SendNode* last = nullptr;
+    for (const std::shared_ptr<SendBuffer>& sendBuffer : sendBuffers)
+    {
+        SendNode* node = LSendNodeCache.Alloc();
+        node->buffer = sendBuffer;
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        if (last)
+            last->next.store(node, std::memory_order_relaxed);
+        else
+            first = node;
+        last = node;
+    }
+
+    const int32_t prevCount = _count.fetch_add(static_cast<int32_t>(sendBuffers.size()), std::memory_order_acq_rel);
+    _queue.PushChain(first, last);
+
+    return prevCount == 0 || Unpark();
+}
+
+std::shared_ptr<SendBuffer> SendQueue::Pop()
+{
+    SendNode* node = static_cast<SendNode*>(_queue.Pop());
+    if (node == nullptr)
+        return nullptr;
+
+    std::shared_ptr<SendBuffer> sendBuffer = std::move(node->buffer);
+    LSendNodeCache.Free(node);
+    return sendBuffer;
+}
+
+bool SendQueue::Release(int32_t count)
+{
+    //  Ͱ  ۽  ״ Ѵ
+    const int32_t prevCount = _count.fetch_sub(count, std::memory_order_acq_rel);
+    assert(prevCount >= count);
+    return prevCount != count;
+}
+
+bool SendQueue::Park()
+{
+    // ڴ 带   _parked  , ⼭ _parked     
+    //  潺 п   ϳ ݵ 븦 
+    _parked.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_queue.IsLinked() == false)
+        return true;
+
+    //   ̾.  ƹ ڵ  ʾ   
+    return _parked.exchange(false) == false;
+}
+
+bool SendQueue::Unpark()
+{
+    // Һڰ  ٸ  ־ٸ ̹ ڰ ۽ ̾ Ǵ
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_parked.load(std::memory_order_relaxed) == false)
+        return false;
+
+    return _parked.exchange(false);
+}
@@ -2,6 +2,7 @@
 #include "Service.h"
 #include "Session.h"
 #include "Listener.h"
+#include "AsioCore.h"
 
 #include "ThreadManager.h"
 
@@ -22,39 +23,85 @@ Service::~Service()
 
 void Service::CloseService()
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    for (const auto& session : _sessions)
-        //session->Disconnect("Service Close");
+    //_sessions.ForEach([](const SessionRef& session) { session->Disconnect("Service Close"); });
+    _sessions.Clear();
 
-    _sessions.clear();
+    std::lock_guard<std::mutex> lock(_groupLock);
+    _groups.clear();
 }
 
 void Service::Broadcast(std::shared_ptr<SendBuffer> sendBuffer)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    for (const auto& session : _sessions)
-        session->Send(sendBuffer);
+    //  ȸϹǷ   accept / disconnect   ʴ´
+    _sessions.ForEach([&sendBuffer](const SessionRef& session) { session->Send(sendBuffer); });
 }
 
 SessionRef Service::CreateSession()
 {
-    SessionRef session = _sessionFactory(_ioc);
+    return CreateSession(_core ? _core->NextIoContext() : _ioc);
+}
+
+SessionRef Service::CreateSession(asio::io_context& ioc)
+{
+    SessionRef session = _sessionFactory(ioc);
     session->SetService(shared_from_this());
     return session;
 }
 
 void Service::AddSession(SessionRef session)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    _sessions.insert(session);
-    _sessionCount++;
+    SessionId id = _sessions.Add(session);
+    if (id == 0)
+        return;
+
+    session->_sessionId.store(id);
+
+    if (_core)
+        _core->AddLoad(session->GetIoContext(), 1);
+
+    // ID  ޱ  ٸ 忡 ٸ ⼭  Ѵ
+    if (session->IsConnected() == false)
+        ReleaseSession(session);
 }
 
 void Service::ReleaseSession(SessionRef session)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    _sessions.erase(session);
-    _sessionCount--;
+    session->LeaveAllGroups();
+
+    //     ص   
+    if (_sessions.Remove(session->GetSessionId()) == false)
+        return;
+
+    if (_core)
+        _core->AddLoad(session->GetIoContext(), -1);
+}
+
+BroadcastGroupRef Service::GetOrCreateGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    BroadcastGroupRef& group = _groups[groupId];
+    if (group == nullptr)
+        group = std::make_shared<BroadcastGroup>(groupId);
+    return group;
+}
+
+BroadcastGroupRef Service::FindGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    auto it = _groups.find(groupId);
+    return it != _groups.end() ? it->second : nullptr;
+}
+
+void Service::RemoveGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    _groups.erase(groupId);
+}
+
+void Service::Broadcast(uint64_t groupId, std::shared_ptr<SendBuffer> sendBuffer)
+{
+    if (BroadcastGroupRef group = FindGroup(groupId))
+        group->Broadcast(std::move(sendBuffer));
 }
 
 /*-----------------
@@ -100,54 +147,20 @@ bool ServerService::Start()
     if (!CanStart())
         return false;
 
-    std::error_code ec;
-    auto endpoint = _netAddress.GetEndpoint();
-
-    _acceptor = std::make_unique<asio::ip::tcp::acceptor>(_ioc, endpoint);
-    if (_acceptor->is_open() == false)
+    _listener = std::make_shared<Listener>(_netAddress.GetEndpoint(), _backlog, _pendingAcceptCount, _reusePort);
+    if (_listener->StartAccept(std::static_pointer_cast<ServerService>(shared_from_this())) == false)
+    {
+        _listener = nullptr;
         return false;
+    }
 
-    StartAccept();
     return true;
 }
 
 void ServerService::CloseService()
 {
-    if (_acceptor)
-        _acceptor->close();
+    if (_listener)
+        _listener->Stop();
 
     Service::CloseService();
-}
-
-void ServerService::StartAccept()
-{
-    // ִ   üũ
-    if (GetCurrentSessionCount() >= GetMaxSessionCount())
-    {
-        std::cout << "Max sessions reached!" << std::endl;
-        return;
-    }
-
-    SessionRef session = CreateSession();
-    _acceptor->async_accept(
-        session->GetSocket(),
-        [this, session](const std::error_code& error)
-        {
-            if (!error)
-            {
-                if (GetCurrentSessionCount() < GetMaxSessionCount())
-                {
-                    session->ProcessConnect();
-                    AddSession(session);
-                }
-                else
-                {
-                    //   ʰǸ  ź
-                    session->Disconnect("Max sessions");
-                }
-            }
-
-            StartAccept(); //   
-        }
-    );
 }
\ No newline at end of file
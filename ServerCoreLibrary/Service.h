@@ -1,9 +1,13 @@
 #pragma once
 #include "NetAddress.h"
 #include "CorePch.h"
+#include "SessionRegistry.h"
+#include "BroadcastGroup.h"
+#include "Compression.h"
 
 class NetAddress;
 class Session;
+class AsiocCore;
 using SessionRef = std::shared_ptr<Session>;
 //using SessionFactory = std::function<SessionRef(asio::io_context&)>;
 using SessionFactory = std::function<SessionRef(asio::io_context&)>;
@@ -14,6 +18,23 @@ enum class ServiceType : uint8_t
     Client
 };
 
+// 큐가 비어 있던 세션에 Send 가 들어왔을 때 언제 쓰기를 시작할지
+enum class SendFlushMode : uint8_t
+{
+    Immediate,      // 바로 쓴다 (기본)
+    EndOfHandler,   // 지금 돌고 있는 핸들러들이 끝난 뒤 모아서 한 번에 쓴다
+    Window,         // 지정한 시간(us) 동안 모았다가 한 번에 쓴다
+};
+
+// 세션 송신 큐가 high watermark 를 넘었을 때의 처리
+enum class SendBackpressurePolicy : uint8_t
+{
+    Notify,         // OnSendBackpressure 만 호출한다
+    DropDroppable,  // 적체가 풀릴 때까지 Droppable 패킷을 버린다 (새로 오는 것, 큐에서 꺼내는 것 모두)
+    Coalesce,       // 적체 중 들어온 Droppable 패킷은 가장 최신 것 하나만 남겼다가 풀리면 보낸다
+    Disconnect,     // 연결을 끊는다
+};
+
 /*-------------
     Service
 --------------*/
@@ -29,27 +50,97 @@ public:
     virtual void CloseService();
 
     void SetSessionFactory(SessionFactory factory) { _sessionFactory = factory; }
+    // 샤드 모드 AsiocCore 를 지정하면 세션마다 샤드 io_context 를 골라 배정한다
+    void SetAsioCore(AsiocCore* core) { _core = core; }
+    // 세션 수신 링 버퍼 크기 (유휴 클라이언트 위주면 16KB 정도로 줄인다)
+    void SetRecvBufferSize(int32_t size) { _recvBufferSize = size; }
+    // 유휴 세션 모드 : 세션이 수신 버퍼를 들고 있지 않고, 데이터가 올 때만 스레드 풀에서 빌린다
+    void SetLazyRecvBuffer(bool lazy) { _lazyRecvBuffer = lazy; }
+    // 64KB 를 넘는 큰 메시지(PacketSession::SendLargeMessage) 를 받을 최대 크기. 0 이면 받지 않는다
+    void SetMaxLargeMessageSize(uint32_t size) { _maxLargeMessageSize = size; }
+    // 작은 패킷이 많을 때 쓰기 호출을 줄인다. 접속 이후에 만들어지는 세션부터 적용된다
+    void SetSendFlushPolicy(SendFlushMode mode, int32_t windowUs = 0)
+    {
+        _sendFlushMode = mode;
+        _sendFlushWindowUs = windowUs;
+    }
 
     void Broadcast(std::shared_ptr<class SendBuffer> sendBuffer);
     SessionRef CreateSession();
+    SessionRef CreateSession(asio::io_context& ioc);
     void AddSession(SessionRef session);
     void ReleaseSession(SessionRef session);
+    SessionRef FindSession(SessionId id) { return _sessions.Find(id); }
+
+    /* Broadcast Group (방 / 존 / 채널 번호) */
+    BroadcastGroupRef GetOrCreateGroup(uint64_t groupId);
+    BroadcastGroupRef FindGroup(uint64_t groupId);
+    void RemoveGroup(uint64_t groupId);
+    void Broadcast(uint64_t groupId, std::shared_ptr<class SendBuffer> sendBuffer);
 
     ServiceType GetServiceType() const { return _type; }
     const NetAddress& GetNetAddress() const { return _netAddress; }
-    int32_t GetCurrentSessionCount() const { return _sessionCount; }
+    int32_t GetCurrentSessionCount() const { return _sessions.Count(); }
     int32_t GetMaxSessionCount() const { return _maxSessionCount; }
     asio::io_context& GetIOContext() { return _ioc; }
+    AsiocCore* GetAsioCore() const { return _core; }
+    int32_t GetRecvBufferSize() const { return _recvBufferSize; }
+    bool IsLazyRecvBuffer() const { return _lazyRecvBuffer; }
+    uint32_t GetMaxLargeMessageSize() const { return _maxLargeMessageSize; }
+    // recvTimeoutMs 동안 아무것도 받지 못하면 끊는다. keepAliveMs 동안 보낸 것이 없으면 OnKeepAlive 호출. 0 이면 끔
+    void SetIdleTimeout(int32_t recvTimeoutMs, int32_t keepAliveMs = 0)
+    {
+        _recvIdleTimeoutMs = recvTimeoutMs;
+        _keepAliveMs = keepAliveMs;
+    }
+    int32_t GetRecvIdleTimeoutMs() const { return _recvIdleTimeoutMs; }
+    int32_t GetKeepAliveMs() const { return _keepAliveMs; }
+
+    // highWatermark 바이트 이상 쌓이면 적체, lowWatermark 이하로 빠지면 해제. 0 이면 제한 없음
+    void SetSendBackpressure(int64_t highWatermark, int64_t lowWatermark, SendBackpressurePolicy policy)
+    {
+        _sendHighWatermark = highWatermark;
+        _sendLowWatermark = lowWatermark;
+        _sendBackpressurePolicy = policy;
+    }
+    int64_t GetSendHighWatermark() const { return _sendHighWatermark; }
+    int64_t GetSendLowWatermark() const { return _sendLowWatermark; }
+    SendBackpressurePolicy GetSendBackpressurePolicy() const { return _sendBackpressurePolicy; }
+    // 서비스의 모든 세션 송신 큐에 쌓여 있는 바이트 수
+    int64_t GetQueuedSendBytes() const { return _queuedSendBytes->load(std::memory_order_relaxed); }
+    std::shared_ptr<std::atomic<int64_t>> GetQueuedSendBytesCounter() const { return _queuedSendBytes; }
+
+    SendFlushMode GetSendFlushMode() const { return _sendFlushMode; }
+    int32_t GetSendFlushWindowUs() const { return _sendFlushWindowUs; }
+
+    // 접속하는 모든 세션에 압축을 켠다 (상대도 같은 설정이어야 한다)
+    // 세션마다 협상하려면 여기서는 끄고, 핸드셰이크 패킷을 주고받은 뒤 Session::EnableCompression 을 호출한다
+    void SetCompression(const CompressionOptions& options) { _compression = options; }
+    const CompressionOptions& GetCompression() const { return _compression; }
 
 protected:
     asio::io_context& _ioc;
     ServiceType _type;
     NetAddress _netAddress;
     int32_t _maxSessionCount;
-    int32_t _sessionCount = 0;
     SessionFactory _sessionFactory;
-    std::recursive_mutex _lock;
-    std::set<SessionRef> _sessions;
+    AsiocCore* _core = nullptr;
+    int32_t _recvBufferSize = 0x10000; // 64KB
+    bool _lazyRecvBuffer = false;
+    uint32_t _maxLargeMessageSize = 0;
+    SendFlushMode _sendFlushMode = SendFlushMode::Immediate;
+    int32_t _sendFlushWindowUs = 0;
+    int32_t _recvIdleTimeoutMs = 0;
+    int32_t _keepAliveMs = 0;
+    int64_t _sendHighWatermark = 0;
+    int64_t _sendLowWatermark = 0;
+    SendBackpressurePolicy _sendBackpressurePolicy = SendBackpressurePolicy::Notify;
+    CompressionOptions _compression;
+    // 세션이 서비스보다 오래 살 수 있으므로 공유해서 들고 있는다
+    std::shared_ptr<std::atomic<int64_t>> _queuedSendBytes = std::make_shared<std::atomic<int64_t>>(0);
+    SessionRegistry _sessions;
+    std::mutex _groupLock;
+    std::unordered_map<uint64_t, BroadcastGroupRef> _groups;
 };
 
 /*-----------------
@@ -79,9 +170,25 @@ public:
     virtual bool Start() override;
     virtual void CloseService() override;
 
+    // Start 전에 호출. backlog : listen 대기열 크기, pendingAcceptCount : acceptor 당 동시 accept 수
+    // reusePort : 샤드마다 SO_REUSEPORT acceptor 를 연다 (같은 포트를 이미 누가 쓰고 있으면 Start 실패)
+    void SetAcceptOptions(int32_t backlog, int32_t pendingAcceptCount, bool reusePort = false)
+    {
+        _backlog = backlog;
+        _pendingAcceptCount = pendingAcceptCount;
+        _reusePort = reusePort;
+    }
+
+    std::shared_ptr<class Listener> GetListener() { return _listener; }
+
+    // 중단 외의 accept 실패 (EMFILE 등). Listener 가 backoff 뒤 다시 걸기 전에 acceptor 의 io_context 에서 호출한다
+    virtual void OnAcceptError(const std::error_code& error, std::chrono::milliseconds backoff) {}
+
 private:
-    void StartAccept();
-    std::unique_ptr<asio::ip::tcp::acceptor> _acceptor;
+    std::shared_ptr<class Listener> _listener;
+    int32_t _backlog = asio::socket_base::max_listen_connections;
+    int32_t _pendingAcceptCount = 4;
+    bool    _reusePort = false;
 };
 
 
@@ -93,6 +200,7 @@ private:
 #include "Service.h"
 #include "Session.h"
 #include "Listener.h"
+#include "AsioCore.h"
 
 #include "ThreadManager.h"
 
@@ -113,39 +221,85 @@ Service::~Service()
 
 void Service::CloseService()
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    for (const auto& session : _sessions)
-        //session->Disconnect("Service Close");
+    //_sessions.ForEach([](const SessionRef& session) { session->Disconnect("Service Close"); });
+    _sessions.Clear();
 
-    _sessions.clear();
+    std::lock_guard<std::mutex> lock(_groupLock);
+    _groups.clear();
 }
 
 void Service::Broadcast(std::shared_ptr<SendBuffer> sendBuffer)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    for (const auto& session : _sessions)
-        session->Send(sendBuffer);
+    // 스냅샷을 순회하므로 그 사이 accept / disconnect 를 막지 않는다
+    _sessions.ForEach([&sendBuffer](const SessionRef& session) { session->Send(sendBuffer); });
 }
 
 SessionRef Service::CreateSession()
 {
-    SessionRef session = _sessionFactory(_ioc);
+    return CreateSession(_core ? _core->NextIoContext() : _ioc);
+}
+
+SessionRef Service::CreateSession(asio::io_context& ioc)
+{
+    SessionRef session = _sessionFactory(ioc);
     session->SetService(shared_from_this());
     return session;
 }
 
 void Service::AddSession(SessionRef session)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    _sessions.insert(session);
-    _sessionCount++;
+    SessionId id = _sessions.Add(session);
+    if (id == 0)
+        return;
+
+    session->_sessionId.store(id);
+
+    if (_core)
+        _core->AddLoad(session->GetIoContext(), 1);
+
+    // ID 를 받기 전에 다른 스레드에서 끊겼다면 여기서 대신 해제한다
+    if (session->IsConnected() == false)
+        ReleaseSession(session);
 }
 
 void Service::ReleaseSession(SessionRef session)
 {
-    std::unique_lock<std::recursive_mutex> lock(_lock);
-    _sessions.erase(session);
-    _sessionCount--;
+    session->LeaveAllGroups();
+
+    // 같은 세션을 두 번 해제해도 한 번만 빠진다
+    if (_sessions.Remove(session->GetSessionId()) == false)
+        return;
+
+    if (_core)
+        _core->AddLoad(session->GetIoContext(), -1);
+}
+
+BroadcastGroupRef Service::GetOrCreateGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    BroadcastGroupRef& group = _groups[groupId];
+    if (group == nullptr)
+        group = std::make_shared<BroadcastGroup>(groupId);
+    return group;
+}
+
+BroadcastGroupRef Service::FindGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    auto it = _groups.find(groupId);
+    return it != _groups.end() ? it->second : nullptr;
+}
+
+void Service::RemoveGroup(uint64_t groupId)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    _groups.erase(groupId);
+}
+
+void Service::Broadcast(uint64_t groupId, std::shared_ptr<SendBuffer> sendBuffer)
+{
+    if (BroadcastGroupRef group = FindGroup(groupId))
+        group->Broadcast(std::move(sendBuffer));
 }
 
 /*-----------------
@@ -191,54 +345,20 @@ bool ServerService::Start()
     if (!CanStart())
         return false;
 
-    std::error_code ec;
-    auto endpoint = _netAddress.GetEndpoint();
-
-    _acceptor = std::make_unique<asio::ip::tcp::acceptor>(_ioc, endpoint);
-    if (_acceptor->is_open() == false)
+    _listener = std::make_shared<Listener>(_netAddress.GetEndpoint(), _backlog, _pendingAcceptCount, _reusePort);
+    if (_listener->StartAccept(std::static_pointer_cast<ServerService>(shared_from_this())) == false)
+    {
+        _listener = nullptr;
         return false;
+    }
 
-    StartAccept();
     return true;
 }
 
 void ServerService::CloseService()
 {
-    if (_acceptor)
-        _acceptor->close();
+    if (_listener)
+        _listener->Stop();
 
     Service::CloseService();
-}
-
-void ServerService::StartAccept()
-{
-    // 최대 세션 수 체크
-    if (GetCurrentSessionCount() >= GetMaxSessionCount())
-    {
-        std::cout << "Max sessions reached!" << std::endl;
-        return;
-    }
-
-    SessionRef session = CreateSession();
-    _acceptor->async_accept(
-        session->GetSocket(),
-        [this, session](const std::error_code& error)
-        {
-            if (!error)
-            {
-                if (GetCurrentSessionCount() < GetMaxSessionCount())
-                {
-                    session->ProcessConnect();
-                    AddSession(session);
-                }
-                else
-                {
-                    // 세션 수가 초과되면 연결 거부
-                    session->Disconnect("Max sessions");
-                }
-            }
-
-            StartAccept(); // 다음 연결 대기
-        }
-    );
 }
\ No newline at end of file
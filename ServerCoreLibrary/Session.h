@@ -4,6 +4,14 @@
 #include "SendBuffer.h"
 #include "NetAddress.h"
 #include "AsioEvent.h"
+#include "SessionRegistry.h"
+#include "BroadcastGroup.h"
+#include "Service.h"
+#include "Metrics.h"
+#include "TimerWheel.h"
+#include "JobQueue.h"
+#include "HandlerAllocator.h"
+#include "Compression.h"
 
 using asio::ip::tcp;
 
@@ -13,14 +21,20 @@ class SendBuffer;
 using SendBufferRef = std::shared_ptr<SendBuffer>;
 class AsioEvent;
 
-class Session : public std::enable_shared_from_this<Session>
+// ǵ JobQueue  DoAsync  ѱ      ȴ
+// (OnRecv  I/O ݹ ü Ϸ I/O 忡 ȣȴ)
+class Session : public JobQueue
 {
     friend class Service;
     friend class ServerService;
+    friend class Listener;
+    friend class BroadcastGroup;
+    friend class CoroutineSession;
 
     enum
     {
-        BUFFER_SIZE = 0x10000, // 64KB
+        BUFFER_SIZE = 0x10000, // 64KB (񽺰   ⺻   ũ)
+        MAX_SEND_IOV = 64,     //       (asio  ѵ, IOV_MAX )
     };
 
 public:
@@ -30,8 +44,10 @@ public:
     /* External Interface */
     void                Start();
     void                Send(std::shared_ptr<SendBuffer> sendBuffer);
+    void                Send(const std::vector<std::shared_ptr<SendBuffer>>& sendBuffers);  // OpenLarge   ū ޽ (  )
     bool                Connect();
-    void                Disconnect(const char* cause);
+    void                Disconnect(const char* cause) { Disconnect(DisconnectReason::User, cause); }
+    void                Disconnect(DisconnectReason reason, const char* cause = nullptr);
 
     void                SetService(std::shared_ptr<Service> service) { _service = service; }
     std::shared_ptr<Service> GetService() { return _service.lock(); }
@@ -40,25 +56,62 @@ public:
     void                SetNetAddress(NetAddress address) { _netAddress = address; }
     NetAddress          GetAddress() { return _netAddress; }
     asio::ip::tcp::socket& GetSocket() { return _socket; }
+    asio::io_context&   GetIoContext() { return _ioContext; }
     bool                IsConnected() { return _connected; }
+    SessionId           GetSessionId() const { return _sessionId; }
+    // OnDisconnected ȿ ȿϴ
+    DisconnectReason    GetDisconnectReason() const { return _disconnectReason; }
+    const std::string&  GetDisconnectCause() const { return _disconnectCause; }
     std::shared_ptr<Session> GetSessionRef() { return std::static_pointer_cast<Session>(shared_from_this()); }
 
+    /* Compression */
+    //   Ŷ ϰ,    Ŷ ޴´ (ڵ   false)
+    // Ǵ  , OnConnected   ݹ(ڵũ ó) ȿ ȣѴ
+    bool                EnableCompression(const CompressionOptions& options);
+    bool                IsCompressionEnabled() const { return _compressionEnabled.load(std::memory_order_acquire); }
+    const CompressionOptions& GetCompression() const { return _compression; }
+
 private:
     void Dispatch(EventType type, size_t bytes);
 
+    /* Broadcast Group */
+    void                AddGroup(BroadcastGroupRef group);
+    void                RemoveGroup(BroadcastGroup* group);
+    void                LeaveAllGroups();
+
 protected:
     /*  ڵ忡  */
     virtual void        OnConnected() {}
     virtual int32_t     OnRecv(BYTE* buffer, int32_t len) { return len; }
     virtual void        OnSend(int32_t len) {}
     virtual void        OnDisconnected() {}
+    // ۽ ť high watermark   true, low watermark Ʒ  false
+    virtual void        OnSendBackpressure(bool backpressured, int64_t queuedBytes) {}
+    // keepAlive ð      ( Ŷ  ȴ)
+    virtual void        OnKeepAlive() {}
 
 private:
     /* Network Core */
     //void                RegisterConnect();
     //void                RegisterDisconnect();
+    //    Ѵ (CoroutineSession  ݹ  ڷƾ ޴´)
+    virtual void        BeginRecv() { RegisterRecv(); }
+    //    ȿ ٸ ִ ۾  (CoroutineSession  ü  AsyncSend)
+    virtual void        CancelWaits() {}
     void                RegisterRecv();
     void                RegisterSend();
+    // ۽ ť ֱ⸸ Ѵ. ۽   true ̰, ȣ  FlushSend  ҷ Ѵ
+    bool                EnqueueSend(std::shared_ptr<SendBuffer> sendBuffer);
+    void                FlushSend();
+    bool                AcquireSendBytes(const std::shared_ptr<SendBuffer>& sendBuffer);
+    bool                AcquireSendBytes(int64_t size);    // Droppable å  ü Ʈ ø
+    void                ReleaseSendBytes(int64_t bytes);
+    int64_t             SubtractSendBytes(int64_t bytes);  //  ü Ʈ ش
+
+    /* Idle Timer */
+    static int64_t      NowMs();
+    void                RegisterIdleCheck();
+    void                ProcessIdleCheck();
 
     void                ProcessConnect();
     void                ProcessDisconnect();
@@ -68,16 +121,51 @@ private:
     void                HandleError(const std::error_code& error);
 
 private:
+    asio::io_context&          _ioContext;
     asio::ip::tcp::socket      _socket;
+    HandlerMemory              _handlerMemory;  //   accept / connect / recv / send ۾ 
     NetAddress                 _netAddress;
     std::atomic<bool>          _connected = false;
+    std::atomic<SessionId>     _sessionId = 0;  // 񽺿 ϵ  ޴´
+    DisconnectReason           _disconnectReason = DisconnectReason::None;
+    std::string                _disconnectCause;
+
+    std::mutex                 _groupLock;
+    std::vector<std::weak_ptr<BroadcastGroup>> _groups;  //    ׷
 
     std::weak_ptr<Service>     _service;
-    RecvBuffer                 _recvBuffer;
+    std::unique_ptr<RecvBuffer> _recvBuffer;   //   忡 Ͱ    
+
+    SendQueue                  _sendQueue;
+    SendFlushMode              _sendFlushMode = SendFlushMode::Immediate;   //     ޾ д
+    std::chrono::microseconds  _sendFlushWindow{ 0 };
+    std::unique_ptr<asio::steady_timer> _sendFlushTimer;                 // Window 忡 
+
+    // ۽ ü (    ޾ д, high  0 ̸  )
+    std::atomic<int64_t>       _sendQueuedBytes = 0;
+    int64_t                    _sendHighWatermark = 0;
+    int64_t                    _sendLowWatermark = 0;
+    SendBackpressurePolicy     _sendBackpressurePolicy = SendBackpressurePolicy::Notify;
+    std::atomic<bool>          _sendBackpressured = false;
+    std::shared_ptr<std::atomic<int64_t>> _serviceQueuedBytes;
+    std::mutex                 _coalesceLock;
+    std::shared_ptr<SendBuffer> _coalescedBuffer;                       // Coalesce å ü   ֽ Ŷ
+
+    //  ˻ (Ǹ io_context  TimerWheel  Ÿ̸ ϳ)
+    int32_t                    _recvIdleTimeoutMs = 0;
+    int32_t                    _keepAliveMs = 0;
+    std::atomic<int64_t>       _lastRecvMs = 0;
+    std::atomic<int64_t>       _lastSendMs = 0;
+    std::atomic<TimerId>       _idleTimer = 0;
 
-    std::mutex                 _sendLock;
-    std::queue<std::shared_ptr<SendBuffer>> _sendQueue;
-    std::atomic<bool>          _sendRegistered = false;
+    //  (_compressionEnabled  ѱ  _compression  ä ķδ ٲ ʴ´)
+    CompressionOptions         _compression;
+    std::atomic<bool>          _compressionEnabled = false;
+
+    // ۽   常  (, ⸶ Ҵ ʴ´)
+    std::array<asio::const_buffer, MAX_SEND_IOV>               _sendIov;
+    std::array<std::shared_ptr<SendBuffer>, MAX_SEND_IOV>      _sendBatch;
+    int32_t                    _sendBatchCount = 0;
 };
 
 /*-----------------
@@ -89,8 +177,40 @@ struct PacketHeader
     uint16_t id;
 };
 
+// PacketHeader::size  0 ̸ ū ޽.  ڿ uint32 ü ũⰡ   ̾
+// [size = 0][id][uint32 payloadSize][payload ...]
+struct LargePacketHeader
+{
+    PacketHeader    header;
+    uint32_t        payloadSize;
+};
+
+// ū ޽  .  ŭ ٷ ѱǷ ü   ʴ´
+// data   ۸ ŰǷ OnRecvLargeMessage ȿ ȿϴ
+struct LargeMessageChunk
+{
+    uint16_t                id;
+    uint32_t                offset;     //     ġ
+    uint32_t                totalSize;  //  ü ũ
+    std::span<const BYTE>   data;
+
+    bool IsFirst() const { return offset == 0; }
+    bool IsLast() const { return offset + data.size() == totalSize; }
+};
+
+//    ϼ Ŷ ϳ ( ,  )
+//    ȿϴ
+struct PacketView
+{
+    BYTE*       buffer;
+    uint16_t    size;
+    uint16_t    id;
+};
+
 class PacketSession : public Session
 {
+    enum { MAX_PACKET_BATCH = 256 };
+
 public:
     PacketSession(asio::io_context& ioc) : Session(ioc) {}
     virtual ~PacketSession() {}
@@ -100,9 +220,24 @@ public:
         return std::static_pointer_cast<PacketSession>(shared_from_this());
     }
 
+    // 64KB    ִ ޽ ū ޽   (޴  񽺿 SetMaxLargeMessageSize ʿ)
+    void SendLargeMessage(uint16_t id, std::span<const BYTE> payload);
+    static std::vector<std::shared_ptr<SendBuffer>> MakeLargeMessage(uint16_t id, std::span<const BYTE> payload);
+
 protected:
     virtual int32_t OnRecv(BYTE* buffer, int32_t len) sealed;
-    virtual void OnRecvPacket(BYTE* buffer, int32_t len) abstract;
+    //     ϼ Ŷ Ƽ   ѱ (ִ MAX_PACKET_BATCH )
+    //   Ŷ OnRecvPacket  ȣѴ
+    virtual void OnRecvPackets(std::span<const PacketView> packets);
+    virtual void OnRecvPacket(BYTE* buffer, int32_t len) {}
+    // ū ޽  ϴ   ȣȴ ( ޽    )
+    virtual void OnRecvLargeMessage(const LargeMessageChunk& chunk) {}
+
+private:
+    // ް ִ ū ޽ (_largeRemain  0  ƴϸ  ʹ ̴)
+    uint16_t    _largeId = 0;
+    uint32_t    _largeTotal = 0;
+    uint32_t    _largeRemain = 0;
 };
 
 ================================================================================
@@ -116,37 +251,88 @@ protected:
 #include <iostream>
 
 Session::Session(asio::io_context& ioc)
-    : _socket(ioc)
-    , _recvBuffer(BUFFER_SIZE)
+    : _ioContext(ioc)
+    , _socket(ioc)
 {
 }
 
 Session::~Session()
 {
-    Disconnect("Destructor");
+    Disconnect(DisconnectReason::Destructor);
 }
 
 void Session::Start()
 {
-    RegisterRecv();
+    BeginRecv();
 }
 
 void Session::Send(std::shared_ptr<SendBuffer> sendBuffer)
+{
+    //    send ۾   ο send ۾ 
+    if (EnqueueSend(std::move(sendBuffer)))
+        FlushSend();
+}
+
+bool Session::EnqueueSend(std::shared_ptr<SendBuffer> sendBuffer)
 {
     if (!IsConnected())
+        return false;
+
+    //   ̸ ົ  ( ۴ ó       )
+    if (IsCompressionEnabled())
+    {
+        //  ʰ   Ŷ̶ 0xFFFF  ޴   Ŷ Ǯٰ ´
+        PacketHeader header{};
+        if (sendBuffer->WriteSize() >= sizeof(PacketHeader))
+            ::memcpy(&header, sendBuffer->Buffer(), sizeof(PacketHeader));
+
+        assert(header.size == 0 || header.id != COMPRESSED_PACKET_ID);
+        if (header.size != 0 && header.id == COMPRESSED_PACKET_ID)
+            return false;
+
+        sendBuffer = PacketCompressor::Compress(sendBuffer, _compression);
+    }
+
+    if (AcquireSendBytes(sendBuffer) == false)
+        return false;
+
+    return _sendQueue.Push(std::move(sendBuffer));
+}
+
+void Session::Send(const std::vector<std::shared_ptr<SendBuffer>>& sendBuffers)
+{
+    if (!IsConnected() || sendBuffers.empty())
         return;
 
-    bool registerSend = false;
+    //  ϳ   Ƿ ü å ޽ ü   ϰ,
+    //  ų Coalesce    ʴ´
+    int64_t totalSize = 0;
+    for (const std::shared_ptr<SendBuffer>& sendBuffer : sendBuffers)
     {
-        std::lock_guard<std::mutex> lock(_sendLock);
-        _sendQueue.push(sendBuffer);
-        //    send ۾   ο send ۾ 
-        if (_sendRegistered.exchange(true) == false)
-            registerSend = true;
+        sendBuffer->SetDroppable(false);
+        totalSize += sendBuffer->WriteSize();
     }
 
-    if (registerSend)
-        RegisterSend();
+    if (AcquireSendBytes(totalSize) == false)
+        return;
+
+    //   ̾ Ƿ ٸ  Send   ̿  ʴ´
+    if (_sendQueue.Push(sendBuffers))
+        FlushSend();
+}
+
+bool Session::EnableCompression(const CompressionOptions& options)
+{
+    if (PacketCompressor::IsSupported(options.codec) == false)
+        return false;
+
+    // ̹  ٸ  Send  а   Ƿ ٲ ʴ´
+    if (IsCompressionEnabled())
+        return options.codec == _compression.codec;
+
+    _compression = options;
+    _compressionEnabled.store(true, std::memory_order_release);
+    return true;
 }
 
 bool Session::Connect()
@@ -159,7 +345,7 @@ bool Session::Connect()
         const NetAddress& address = service->GetNetAddress();
         _socket.async_connect(
             address.GetEndpoint(),
-            [this](const std::error_code& error)
+            MakeAllocHandler(_handlerMemory, [this, self = shared_from_this()](const std::error_code& error)
             {
                 if (!error)
                 {
@@ -169,26 +355,71 @@ bool Session::Connect()
                 {
                     HandleError(error);
                 }
-            });
+            }));
         return true;
     }
     return false;
 }
 
-void Session::Disconnect(const char* cause)
+void Session::Disconnect(DisconnectReason reason, const char* cause)
 {
     if (_connected.exchange(false) == false)
         return;
 
+    _disconnectReason = reason;
+    _disconnectCause = cause ? cause : ToString(reason);
+    Metrics::AddDisconnect(reason);
+
+    if (TimerId idleTimer = _idleTimer.exchange(0))
+        TimerWheel::Get(_ioContext).Cancel(idleTimer);
+
+    //  ϰ  ʹ  迡 
+    const int64_t queuedBytes = _sendQueuedBytes.exchange(0);
+    if (_serviceQueuedBytes)
+        _serviceQueuedBytes->fetch_sub(queuedBytes, std::memory_order_relaxed);
+
     std::error_code ec;
     _socket.shutdown(asio::ip::tcp::socket::shutdown_both, ec);
     _socket.close(ec);
 
+    CancelWaits();
     OnDisconnected();
     if (auto service = GetService())
         service->ReleaseSession(GetSessionRef());
 }
 
+void Session::AddGroup(BroadcastGroupRef group)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    _groups.push_back(group);
+}
+
+void Session::RemoveGroup(BroadcastGroup* group)
+{
+    std::lock_guard<std::mutex> lock(_groupLock);
+    std::erase_if(_groups, [group](const std::weak_ptr<BroadcastGroup>& weak)
+        {
+            BroadcastGroupRef ref = weak.lock();
+            return ref == nullptr || ref.get() == group;
+        });
+}
+
+void Session::LeaveAllGroups()
+{
+    std::vector<std::weak_ptr<BroadcastGroup>> groups;
+    {
+        std::lock_guard<std::mutex> lock(_groupLock);
+        groups.swap(_groups);
+    }
+
+    SessionRef self = GetSessionRef();
+    for (const std::weak_ptr<BroadcastGroup>& weak : groups)
+    {
+        if (BroadcastGroupRef group = weak.lock())
+            group->Leave(self);
+    }
+}
+
 void Session::Dispatch(EventType type, size_t bytes)
 {
     switch (type) {
@@ -206,34 +437,90 @@ void Session::RegisterRecv()
     if (!IsConnected())
         return;
 
-    BYTE* buffer = _recvBuffer.WritePos();
-    int32_t len = _recvBuffer.FreeSize();
+    std::shared_ptr<Service> service = GetService();
+    const int32_t bufferSize = service ? service->GetRecvBufferSize() : BUFFER_SIZE;
+    const bool lazyRecvBuffer = service && service->IsLazyRecvBuffer();
+
+    if (_recvBuffer == nullptr)
+    {
+        //    :    Ͱ   ٸ
+        if (lazyRecvBuffer)
+        {
+            _socket.async_wait(
+                asio::socket_base::wait_read,
+                MakeAllocHandler(_handlerMemory, [this, self = shared_from_this(), bufferSize](const std::error_code& error)
+                {
+                    if (error)
+                    {
+                        Disconnect(DisconnectReason::IoError, "RegisterRecv Error");
+                        return;
+                    }
+
+                    // Ͱ    Ǯ ۸ 
+                    _recvBuffer = RecvBufferPool::Pop(bufferSize);
+                    RegisterRecv();
+                }));
+            return;
+        }
+
+        //  ۴ ó    񽺿  ũ 
+        _recvBuffer = std::make_unique<RecvBuffer>(bufferSize);
+    }
+
+    // ۺ ū Ŷ   
+    if (_recvBuffer->FreeSize() == 0)
+    {
+        Disconnect(DisconnectReason::RecvBufferFull);
+        return;
+    }
+
+    BYTE* buffer = _recvBuffer->WritePos();
+    int32_t len = _recvBuffer->FreeSize();
 
     GetSocket().async_read_some(
         asio::buffer(buffer, len),
-        [this](const std::error_code& error, size_t bytesTransferred)
+        MakeAllocHandler(_handlerMemory, [this, self = shared_from_this(), lazyRecvBuffer](const std::error_code& error, size_t bytesTransferred)
         {
             if (!error)
             {
-                if (_recvBuffer.OnWrite(bytesTransferred))
+                Metrics::Add(MetricCounter::RecvCalls);
+                Metrics::Add(MetricCounter::RecvBytes, bytesTransferred);
+
+                const auto handlerStart = std::chrono::steady_clock::now();
+                if (_recvIdleTimeoutMs > 0)
+                    _lastRecvMs.store(std::chrono::duration_cast<std::chrono::milliseconds>(handlerStart.time_since_epoch()).count(), std::memory_order_relaxed);
+
+                if (_recvBuffer->OnWrite(bytesTransferred))
                 {
-                    int32_t dataSize = _recvBuffer.DataSize();
-                    int32_t processLen = OnRecv(_recvBuffer.ReadPos(), dataSize);
-                    if (processLen < 0 || dataSize < processLen || !_recvBuffer.OnRead(processLen))
+                    int32_t dataSize = _recvBuffer->DataSize();
+
+                    int32_t processLen = OnRecv(_recvBuffer->ReadPos(), dataSize);
+                    Metrics::Observe(MetricHistogram::HandlerLatencyNs,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - handlerStart).count());
+                    if (processLen < 0 || dataSize < processLen || !_recvBuffer->OnRead(processLen))
                     {
-                        Disconnect("Read Overflow");
+                        Disconnect(DisconnectReason::ReadOverflow);
                         return;
                     }
 
-                    _recvBuffer.Clean();
+                    _recvBuffer->Clean();
+
+                    // ϼ Ŷ  ó ۸ ش (   )
+                    if (lazyRecvBuffer && _recvBuffer->DataSize() == 0)
+                        RecvBufferPool::Push(std::move(_recvBuffer));
+
                     RegisterRecv();  //   
                 }
             }
+            else if (error == asio::error::eof)
+            {
+                Disconnect(DisconnectReason::PeerClosed);
+            }
             else
             {
-                Disconnect("RegisterRecv Error");
+                Disconnect(DisconnectReason::IoError, "RegisterRecv Error");
             }
-        });
+        }));
 }
 
 void Session::RegisterSend()
@@ -241,55 +528,256 @@ void Session::RegisterSend()
     if (!IsConnected())
         return;
 
-    //   غ
-    std::vector<asio::const_buffer> sendBuffers;
-    std::vector<std::shared_ptr<SendBuffer>> pendingBuffers;
+    //   غ ( ۿ   ڿ ̾ δ)
+    while (true)
     {
-        std::lock_guard<std::mutex> lock(_sendLock);
-        while (!_sendQueue.empty()) {
-            auto buffer = _sendQueue.front();
-            _sendQueue.pop();
-
-            pendingBuffers.push_back(buffer);  //    
-            sendBuffers.push_back(
-                asio::buffer(buffer->Buffer(), buffer->WriteSize())
-            );
+        int32_t dropped = 0;
+        while (_sendBatchCount < MAX_SEND_IOV)
+        {
+            std::shared_ptr<SendBuffer> buffer = _sendQueue.Pop();
+            if (buffer == nullptr)
+                break;
+
+            // ü ߿  Droppable Ŷ 
+            if (_sendBackpressurePolicy == SendBackpressurePolicy::DropDroppable &&
+                buffer->IsDroppable() && _sendBackpressured.load(std::memory_order_relaxed))
+            {
+                ReleaseSendBytes(buffer->WriteSize());
+                dropped++;
+                continue;
+            }
+
+            _sendIov[_sendBatchCount] = asio::buffer(buffer->Buffer(), buffer->WriteSize());
+            _sendBatch[_sendBatchCount] = std::move(buffer);  //    
+            _sendBatchCount++;
         }
-    }
 
-    //  Ͱ ٸ 
-    if (sendBuffers.empty()) {
-        _sendRegistered.store(false);
-        return;
+        //     0    .   ٸ ۽  ´
+        if (dropped > 0 && _sendQueue.Release(dropped) == false && _sendBatchCount == 0)
+            return;
+
+        if (_sendBatchCount > 0)
+            break;
+
+        if (dropped > 0)
+            continue;
+
+        // ۽  ִٸ ť Ͱ ִٴ ̹Ƿ,
+        //  ̴  Push  ڰ     ̴. ٸ ʰ  ڿ ѱ
+        if (_sendQueue.Park())
+            return;
     }
 
+    Metrics::Observe(MetricHistogram::SendQueueDepth, _sendQueue.Count());
+
     // 񵿱  ۾ 
-    auto self = shared_from_this();  //  
     _socket.async_write_some(
-        sendBuffers,
-        [this, self, pendingBuffers](const std::error_code& error, size_t bytesTransferred) {
+        std::span<const asio::const_buffer>(_sendIov.data(), _sendBatchCount),
+        MakeAllocHandler(_handlerMemory, [this, self = shared_from_this()](const std::error_code& error, size_t bytesTransferred) {
             if (!error) {
                 Dispatch(EventType::Send, bytesTransferred);
             }
             else {
                 HandleError(error);
             }
-        }
+        })
     );
 }
 
+void Session::FlushSend()
+{
+    // ۽      ҸǷ Ÿ̸Ӹ  ȣ ʴ´
+    switch (_sendFlushMode)
+    {
+    case SendFlushMode::EndOfHandler:
+        // ť ڿ ɾ θ   ٸ ڵ鷯  Send    
+        asio::post(_ioContext, MakeAllocHandler(_handlerMemory, [this, self = shared_from_this()]() { RegisterSend(); }));
+        break;
+    case SendFlushMode::Window:
+        _sendFlushTimer->expires_after(_sendFlushWindow);
+        _sendFlushTimer->async_wait(MakeAllocHandler(_handlerMemory, [this, self = shared_from_this()](const std::error_code& error) {
+            // ҵ (io_context  ) ⸦  ʴ´.  ݾ ۽ ѵ Բ ´
+            if (error)
+                Disconnect(DisconnectReason::IoError, "Send flush timer aborted");
+            else
+                RegisterSend();
+        }));
+        break;
+    default:
+        RegisterSend();
+        break;
+    }
+}
+
+bool Session::AcquireSendBytes(const std::shared_ptr<SendBuffer>& sendBuffer)
+{
+    if (_sendHighWatermark > 0 && sendBuffer->IsDroppable() && _sendBackpressured.load(std::memory_order_relaxed))
+    {
+        if (_sendBackpressurePolicy == SendBackpressurePolicy::DropDroppable)
+            return false;
+
+        if (_sendBackpressurePolicy == SendBackpressurePolicy::Coalesce)
+        {
+            std::lock_guard<std::mutex> lock(_coalesceLock);
+            _coalescedBuffer = sendBuffer;
+            return false;
+        }
+    }
+
+    return AcquireSendBytes(static_cast<int64_t>(sendBuffer->WriteSize()));
+}
+
+bool Session::AcquireSendBytes(int64_t size)
+{
+    const int64_t queuedBytes = _sendQueuedBytes.fetch_add(size) + size;
+    if (_serviceQueuedBytes)
+        _serviceQueuedBytes->fetch_add(size, std::memory_order_relaxed);
+
+    //   Disconnect  踦   Ƿ ø ŭ ǵ (̹ ٸ  ŭ )
+    if (!IsConnected())
+    {
+        SubtractSendBytes(size);
+        return false;
+    }
+
+    if (_sendHighWatermark > 0 && queuedBytes >= _sendHighWatermark &&
+        _sendBackpressured.exchange(true) == false)
+    {
+        OnSendBackpressure(true, queuedBytes);
+
+        if (_sendBackpressurePolicy == SendBackpressurePolicy::Disconnect)
+        {
+            Disconnect(DisconnectReason::SendBackpressure);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Session::ReleaseSendBytes(int64_t bytes)
+{
+    // ۽   忡 Ҹ
+    const int64_t queuedBytes = SubtractSendBytes(bytes);
+
+    if (queuedBytes > _sendLowWatermark || _sendBackpressured.load(std::memory_order_relaxed) == false)
+        return;
+
+    if (_sendBackpressured.exchange(false) == false)
+        return;
+
+    OnSendBackpressure(false, queuedBytes);
+
+    // ü ߿   ֽ Ŷ  (۽ ̹Ƿ Push  ۽   ʴ´)
+    std::shared_ptr<SendBuffer> coalesced;
+    {
+        std::lock_guard<std::mutex> lock(_coalesceLock);
+        coalesced = std::move(_coalescedBuffer);
+    }
+
+    if (coalesced && AcquireSendBytes(coalesced))
+        _sendQueue.Push(std::move(coalesced));
+}
+
+int64_t Session::SubtractSendBytes(int64_t bytes)
+{
+    // Disconnect   0   ̹  迡  Ʈ̹Ƿ,    ִ ŭ 
+    int64_t queuedBytes = _sendQueuedBytes.load();
+    int64_t subtracted = 0;
+    do
+    {
+        subtracted = std::clamp<int64_t>(bytes, 0, queuedBytes);
+    } while (_sendQueuedBytes.compare_exchange_weak(queuedBytes, queuedBytes - subtracted) == false);
+
+    if (_serviceQueuedBytes)
+        _serviceQueuedBytes->fetch_sub(subtracted, std::memory_order_relaxed);
+
+    return queuedBytes - subtracted;
+}
+
+int64_t Session::NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Session::RegisterIdleCheck()
+{
+    //  Ȯ ð ٸ ( / ۽Ÿ Ÿ̸Ӹ ٽ  ʴ´)
+    int64_t deadline = INT64_MAX;
+    if (_recvIdleTimeoutMs > 0)
+        deadline = std::min(deadline, _lastRecvMs.load(std::memory_order_relaxed) + _recvIdleTimeoutMs);
+    if (_keepAliveMs > 0)
+        deadline = std::min(deadline, _lastSendMs.load(std::memory_order_relaxed) + _keepAliveMs);
+
+    if (deadline == INT64_MAX)
+        return;
+
+    const int64_t delay = std::max<int64_t>(0, deadline - NowMs());
+    _idleTimer.store(TimerWheel::Get(_ioContext).Schedule(std::chrono::milliseconds(delay),
+        [weak = weak_from_this()]()
+        {
+            if (JobQueueRef self = weak.lock())
+                static_cast<Session*>(self.get())->ProcessIdleCheck();
+        }));
+}
+
+void Session::ProcessIdleCheck()
+{
+    if (!IsConnected())
+        return;
+
+    const int64_t now = NowMs();
+    if (_recvIdleTimeoutMs > 0 && now - _lastRecvMs.load(std::memory_order_relaxed) >= _recvIdleTimeoutMs)
+    {
+        Disconnect(DisconnectReason::IdleTimeout);
+        return;
+    }
+
+    if (_keepAliveMs > 0 && now - _lastSendMs.load(std::memory_order_relaxed) >= _keepAliveMs)
+    {
+        _lastSendMs.store(now, std::memory_order_relaxed);
+        OnKeepAlive();
+    }
+
+    RegisterIdleCheck();
+}
+
 void Session::ProcessConnect()
 {
+    if (auto service = GetService())
+    {
+        _recvIdleTimeoutMs = service->GetRecvIdleTimeoutMs();
+        _keepAliveMs = service->GetKeepAliveMs();
+        _sendHighWatermark = service->GetSendHighWatermark();
+        _sendLowWatermark = service->GetSendLowWatermark();
+        _sendBackpressurePolicy = service->GetSendBackpressurePolicy();
+        _serviceQueuedBytes = service->GetQueuedSendBytesCounter();
+
+        _sendFlushMode = service->GetSendFlushMode();
+        _sendFlushWindow = std::chrono::microseconds(service->GetSendFlushWindowUs());
+        if (_sendFlushMode == SendFlushMode::Window && _sendFlushTimer == nullptr)
+            _sendFlushTimer = std::make_unique<asio::steady_timer>(_ioContext);
+
+        if (service->GetCompression().codec != CompressionCodec::None)
+            EnableCompression(service->GetCompression());
+    }
+
     _connected.store(true);
+    Metrics::Add(MetricCounter::SessionsOpened);
 
     //  
     GetService()->AddSession(GetSessionRef());
 
+    //  ˻   
+    _lastRecvMs.store(NowMs());
+    _lastSendMs.store(NowMs());
+    RegisterIdleCheck();
+
     //  ڵ忡 
     OnConnected();
 
     //  
-    RegisterRecv();
+    BeginRecv();
 }
 
 void Session::ProcessDisconnect()
@@ -310,17 +798,45 @@ void Session::ProcessSend(size_t bytesTransferred)
         return;
 
     if (bytesTransferred == 0) {
-        Disconnect("Send bytesTransferred is 0");
+        Disconnect(DisconnectReason::IoError, "Send bytesTransferred is 0");
         return;
     }
 
+    Metrics::Add(MetricCounter::SendCalls);
+    Metrics::Add(MetricCounter::SendBytes, bytesTransferred);
+
+    if (_keepAliveMs > 0)
+        _lastSendMs.store(NowMs(), std::memory_order_relaxed);
+
     //  ڵ忡 
     OnSend(bytesTransferred);
 
-    std::lock_guard<std::mutex> lock(_sendLock);
-    if (_sendQueue.empty())
-        _sendRegistered.store(false);
-    else
+    //   ۴  ´
+    int32_t completed = 0;
+    size_t remain = bytesTransferred;
+    while (completed < _sendBatchCount && remain >= _sendIov[completed].size())
+    {
+        remain -= _sendIov[completed].size();
+        _sendBatch[completed].reset();
+        completed++;
+    }
+
+    // Ϻθ  ۴  ġ ٽ 
+    if (remain > 0)
+        _sendIov[completed] += remain;
+
+    for (int32_t i = completed; i < _sendBatchCount; i++)
+    {
+        _sendIov[i - completed] = _sendIov[i];
+        _sendBatch[i - completed] = std::move(_sendBatch[i]);
+    }
+    _sendBatchCount -= completed;
+    Metrics::Add(MetricCounter::SendBuffers, completed);
+
+    ReleaseSendBytes(bytesTransferred);
+
+    //  ŭ ť ,  ͳ    Ͱ  ̾ 
+    if (_sendQueue.Release(completed))
         RegisterSend();
 }
 
@@ -330,7 +846,7 @@ void Session::HandleError(const std::error_code& error)
         error == asio::error::connection_reset ||
         error == asio::error::connection_aborted)
     {
-        Disconnect("Error");
+        Disconnect(DisconnectReason::IoError, "Error");
     }
     else
     {
@@ -342,20 +858,167 @@ void Session::HandleError(const std::error_code& error)
 int32_t PacketSession::OnRecv(BYTE* buffer, int32_t len)
 {
     int32_t processLen = 0;
+    int32_t packetCount = 0;
+
+    //   ȣ ȿ ̹Ƿ Ǹ   ʰ ÿ д (ʱȭ ʴ´)
+    std::array<PacketView, MAX_PACKET_BATCH> packetViews;
+
+    // ū ޽  ռ  Ŷ  Ѱܾ  ȴ
+    auto flushPackets = [&]()
+        {
+            if (packetCount == 0)
+                return;
+
+            Metrics::Add(MetricCounter::RecvPackets, packetCount);
+            OnRecvPackets(std::span<const PacketView>(packetViews.data(), packetCount));
+            packetCount = 0;
+        };
 
     while (true)
     {
+        // ū ޽  ޴ ̸  ŭ ٷ ѱ
+        if (_largeRemain > 0)
+        {
+            const int32_t chunkSize = static_cast<int32_t>(std::min<int64_t>(_largeRemain, len - processLen));
+            if (chunkSize == 0)
+                break;
+
+            flushPackets();
+            OnRecvLargeMessage(LargeMessageChunk{ _largeId, _largeTotal - _largeRemain, _largeTotal,
+                std::span<const BYTE>(&buffer[processLen], chunkSize) });
+
+            processLen += chunkSize;
+            _largeRemain -= chunkSize;
+            continue;
+        }
+
         int32_t dataSize = len - processLen;
         if (dataSize < sizeof(PacketHeader))
             break;
 
-        PacketHeader* header = reinterpret_cast<PacketHeader*>(&buffer[processLen]);
-        if (dataSize < header->size)
+        // Ŷ  ġ ĵ    Ƿ ؼ д´
+        PacketHeader header;
+        ::memcpy(&header, &buffer[processLen], sizeof(PacketHeader));
+
+        if (header.size == 0)
+        {
+            if (dataSize < sizeof(LargePacketHeader))
+                break;
+
+            LargePacketHeader largeHeader;
+            ::memcpy(&largeHeader, &buffer[processLen], sizeof(LargePacketHeader));
+
+            // ū ޽  ʴ 񽺰ų(ִ ũ 0,  ޽  ʴ´)  ũ⸦  ߸ Ŷ
+            std::shared_ptr<Service> service = GetService();
+            if (service == nullptr || service->GetMaxLargeMessageSize() == 0 ||
+                largeHeader.payloadSize > service->GetMaxLargeMessageSize())
+                return -1;
+
+            flushPackets();
+            processLen += sizeof(LargePacketHeader);
+            Metrics::Add(MetricCounter::RecvPackets);
+
+            _largeId = header.id;
+            _largeTotal = largeHeader.payloadSize;
+            _largeRemain = largeHeader.payloadSize;
+
+            if (_largeTotal == 0)
+                OnRecvLargeMessage(LargeMessageChunk{ _largeId, 0, 0, {} });
+            continue;
+        }
+
+        //   ũ ߸ Ŷ (״ θ  ڸ  д´)
+        if (header.size < sizeof(PacketHeader))
+            return -1;
+
+        if (dataSize < header.size)
             break;
 
-        OnRecvPacket(&buffer[processLen], header->size);
-        processLen += header->size;
+        //   ǿ  Ŷ̴ (  ǿ Ϲ id  ѱ)
+        if (header.id == COMPRESSED_PACKET_ID && IsCompressionEnabled())
+        {
+            std::span<BYTE> original = PacketCompressor::Decompress(&buffer[processLen], header.size, GetCompression());
+            if (original.empty())
+                return -1;
+
+            flushPackets();
+            processLen += header.size;
+
+            for (size_t offset = 0; offset < original.size(); )
+            {
+                PacketHeader inner;
+                ::memcpy(&inner, &original[offset], sizeof(PacketHeader));
+
+                packetViews[packetCount++] = PacketView{ &original[offset], inner.size, inner.id };
+                offset += inner.size;
+
+                if (packetCount == MAX_PACKET_BATCH)
+                    flushPackets();
+            }
+
+            // Ǯ ۴   Ŷ Ƿ ٷ ѱ
+            flushPackets();
+            continue;
+        }
+
+        packetViews[packetCount++] = PacketView{ &buffer[processLen], header.size, header.id };
+        processLen += header.size;
+
+        if (packetCount == MAX_PACKET_BATCH)
+            flushPackets();
     }
 
+    flushPackets();
     return processLen;
+}
+
+void PacketSession::SendLargeMessage(uint16_t id, std::span<const BYTE> payload)
+{
+    Send(MakeLargeMessage(id, payload));
+}
+
+std::vector<std::shared_ptr<SendBuffer>> PacketSession::MakeLargeMessage(uint16_t id, std::span<const BYTE> payload)
+{
+    const LargePacketHeader largeHeader{ PacketHeader{ 0, id }, static_cast<uint32_t>(payload.size()) };
+    const uint32_t totalSize = static_cast<uint32_t>(sizeof(LargePacketHeader) + payload.size());
+
+    // ûũ(ִ 1MB) 迡    ̾  ´
+    std::vector<std::shared_ptr<SendBuffer>> sendBuffers = GSendBufferManager->OpenLarge(totalSize);
+
+    const BYTE* headerBytes = reinterpret_cast<const BYTE*>(&largeHeader);
+    size_t written = 0;
+    for (const std::shared_ptr<SendBuffer>& sendBuffer : sendBuffers)
+    {
+        const uint32_t allocSize = sendBuffer->AllocSize();
+        uint32_t filled = 0;
+
+        while (filled < allocSize)
+        {
+            if (written < sizeof(LargePacketHeader))
+            {
+                const uint32_t copySize = std::min<uint32_t>(allocSize - filled, static_cast<uint32_t>(sizeof(LargePacketHeader) - written));
+                ::memcpy(sendBuffer->Buffer() + filled, headerBytes + written, copySize);
+                filled += copySize;
+                written += copySize;
+            }
+            else
+            {
+                const size_t payloadPos = written - sizeof(LargePacketHeader);
+                const uint32_t copySize = std::min<uint32_t>(allocSize - filled, static_cast<uint32_t>(payload.size() - payloadPos));
+                ::memcpy(sendBuffer->Buffer() + filled, payload.data() + payloadPos, copySize);
+                filled += copySize;
+                written += copySize;
+            }
+        }
+
+        sendBuffer->Close(filled);
+    }
+
+    return sendBuffers;
+}
+
+void PacketSession::OnRecvPackets(std::span<const PacketView> packets)
+{
+    for (const PacketView& packet : packets)
+        OnRecvPacket(packet.buffer, packet.size);
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "SessionRegistry.h"
+#include "Session.h"
+
+SessionId SessionRegistry::Add(SessionRef session)
+{
+    const uint32_t shardIndex = _nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    Shard& shard = _shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    uint32_t slotIndex;
+    if (shard.freeSlots.empty() == false)
+    {
+        slotIndex = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    }
+    else
+    {
+        if (shard.slots.size() >= MAX_SLOT_COUNT)
+            return 0;
+
+        slotIndex = static_cast<uint32_t>(shard.slots.size());
+        shard.slots.emplace_back();
+    }
+
+    Slot& slot = shard.slots[slotIndex];
+    slot.session = std::move(session);
+    shard.snapshot = nullptr;
+
+    _count.fetch_add(1, std::memory_order_relaxed);
+    return MakeId(shardIndex, slotIndex, slot.generation);
+}
+
+bool SessionRegistry::Remove(SessionId id)
+{
+    const uint32_t shardIndex = ShardOf(id);
+    if (id == 0 || shardIndex >= SHARD_COUNT)
+        return false;
+
+    Shard& shard = _shards[shardIndex];
+    SessionRef removed;
+    {
+        std::lock_guard<std::mutex> lock(shard.lock);
+
+        const uint32_t slotIndex = SlotOf(id);
+        if (slotIndex >= shard.slots.size())
+            return false;
+
+        Slot& slot = shard.slots[slotIndex];
+        if (slot.generation != GenerationOf(id) || slot.session == nullptr)
+            return false;
+
+        // 밡    0  Ǹ ID 0  ġǷ ǳʶڴ
+        if (++slot.generation == 0)
+            slot.generation = 1;
+
+        removed = std::move(slot.session);
+        shard.freeSlots.push_back(slotIndex);
+        shard.snapshot = nullptr;
+    }
+
+    //   Ҹڰ  ۿ  ⼭ ´
+    _count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+SessionRef SessionRegistry::Find(SessionId id)
+{
+    const uint32_t shardIndex = ShardOf(id);
+    if (id == 0 || shardIndex >= SHARD_COUNT)
+        return nullptr;
+
+    Shard& shard = _shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    const uint32_t slotIndex = SlotOf(id);
+    if (slotIndex >= shard.slots.size())
+        return nullptr;
+
+    const Slot& slot = shard.slots[slotIndex];
+    if (slot.generation != GenerationOf(id))
+        return nullptr;
+
+    return slot.session;
+}
+
+void SessionRegistry::Clear()
+{
+    for (Shard& shard : _shards)
+    {
+        std::vector<SessionRef> removed;
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            for (uint32_t i = 0; i < shard.slots.size(); i++)
+            {
+                Slot& slot = shard.slots[i];
+                if (slot.session == nullptr)
+                    continue;
+
+                if (++slot.generation == 0)
+                    slot.generation = 1;
+
+                removed.push_back(std::move(slot.session));
+                shard.freeSlots.push_back(i);
+            }
+            shard.snapshot = nullptr;
+        }
+
+        _count.fetch_sub(static_cast<int32_t>(removed.size()), std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<const std::vector<SessionRef>> SessionRegistry::GetSnapshot(Shard& shard)
+{
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    // / ٸ   ״  
+    if (shard.snapshot == nullptr)
+    {
+        auto snapshot = std::make_shared<std::vector<SessionRef>>();
+        snapshot->reserve(shard.slots.size() - shard.freeSlots.size());
+        for (const Slot& slot : shard.slots)
+        {
+            if (slot.session)
+                snapshot->push_back(slot.session);
+        }
+        shard.snapshot = std::move(snapshot);
+    }
+
+    return shard.snapshot;
+}
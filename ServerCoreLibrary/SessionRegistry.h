@@ -0,0 +1,214 @@
+#pragma once
+
+class Session;
+using SessionRef = std::shared_ptr<Session>;
+
+// [generation 32][slot 24][shard 8]. 0  ȿ  ID
+using SessionId = uint64_t;
+
+/*-------------------
+    SessionRegistry
+--------------------*/
+// 帶   + ª . //ȸ O(1)
+//   븦 ÷ ϹǷ,  ID δ   ã  
+// ForEach  庰  ȸϹǷ   ä  ڵ带 θ ʴ´
+class SessionRegistry
+{
+    enum : uint32_t
+    {
+        SHARD_BITS = 8,
+        SHARD_COUNT = 16,
+        SLOT_BITS = 24,
+        MAX_SLOT_COUNT = 1u << SLOT_BITS,
+    };
+
+public:
+    SessionRegistry() = default;
+    SessionRegistry(const SessionRegistry&) = delete;
+    SessionRegistry& operator=(const SessionRegistry&) = delete;
+
+    SessionId   Add(SessionRef session);
+    bool        Remove(SessionId id);
+    SessionRef  Find(SessionId id);
+    void        Clear();
+
+    int32_t     Count() const { return _count.load(std::memory_order_relaxed); }
+
+    template<typename Func>
+    void ForEach(Func&& func)
+    {
+        for (Shard& shard : _shards)
+        {
+            std::shared_ptr<const std::vector<SessionRef>> snapshot = GetSnapshot(shard);
+            for (const SessionRef& session : *snapshot)
+                func(session);
+        }
+    }
+
+private:
+    struct Slot
+    {
+        SessionRef  session;
+        uint32_t    generation = 1;
+    };
+
+    struct alignas(64) Shard
+    {
+        std::mutex                                      lock;
+        std::vector<Slot>                               slots;
+        std::vector<uint32_t>                           freeSlots;
+        std::shared_ptr<const std::vector<SessionRef>>  snapshot;   // null ̸ ٽ 
+    };
+
+    static SessionId MakeId(uint32_t shard, uint32_t slot, uint32_t generation)
+    {
+        return (static_cast<SessionId>(generation) << 32) | (static_cast<SessionId>(slot) << SHARD_BITS) | shard;
+    }
+    static uint32_t ShardOf(SessionId id) { return static_cast<uint32_t>(id & ((1u << SHARD_BITS) - 1)); }
+    static uint32_t SlotOf(SessionId id) { return static_cast<uint32_t>((id >> SHARD_BITS) & (MAX_SLOT_COUNT - 1)); }
+    static uint32_t GenerationOf(SessionId id) { return static_cast<uint32_t>(id >> 32); }
+
+    std::shared_ptr<const std::vector<SessionRef>> GetSnapshot(Shard& shard);
+
+private:
+    std::array<Shard, SHARD_COUNT>  _shards;
+    std::atomic<uint32_t>           _nextShard = 0;
+    std::atomic<int32_t>            _count = 0;
+};
+
+================================================================================
+// SessionRegistry.cpp file content
+================================================================================
+
+#include "pch.h"
+#include "SessionRegistry.h"
+#include "Session.h"
+
+SessionId SessionRegistry::Add(SessionRef session)
+{
+    const uint32_t shardIndex = _nextShard.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    Shard& shard = _shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    uint32_t slotIndex;
+    if (shard.freeSlots.empty() == false)
+    {
+        slotIndex = shard.freeSlots.back();
+        shard.freeSlots.pop_back();
+    }
+    else
+    {
+        if (shard.slots.size() >= MAX_SLOT_COUNT)
+            return 0;
+
+        slotIndex = static_cast<uint32_t>(shard.slots.size());
+        shard.slots.emplace_back();
+    }
+
+    Slot& slot = shard.slots[slotIndex];
+    slot.session = std::move(session);
+    shard.snapshot = nullptr;
+
+    _count.fetch_add(1, std::memory_order_relaxed);
+    return MakeId(shardIndex, slotIndex, slot.generation);
+}
+
+bool SessionRegistry::Remove(SessionId id)
+{
+    const uint32_t shardIndex = ShardOf(id);
+    if (id == 0 || shardIndex >= SHARD_COUNT)
+        return false;
+
+    Shard& shard = _shards[shardIndex];
+    SessionRef removed;
+    {
+        std::lock_guard<std::mutex> lock(shard.lock);
+
+        const uint32_t slotIndex = SlotOf(id);
+        if (slotIndex >= shard.slots.size())
+            return false;
+
+        Slot& slot = shard.slots[slotIndex];
+        if (slot.generation != GenerationOf(id) || slot.session == nullptr)
+            return false;
+
+        // 밡    0  Ǹ ID 0  ġǷ ǳʶڴ
+        if (++slot.generation == 0)
+            slot.generation = 1;
+
+        removed = std::move(slot.session);
+        shard.freeSlots.push_back(slotIndex);
+        shard.snapshot = nullptr;
+    }
+
+    //   Ҹڰ  ۿ  ⼭ ´
+    _count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+SessionRef SessionRegistry::Find(SessionId id)
+{
+    const uint32_t shardIndex = ShardOf(id);
+    if (id == 0 || shardIndex >= SHARD_COUNT)
+        return nullptr;
+
+    Shard& shard = _shards[shardIndex];
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    const uint32_t slotIndex = SlotOf(id);
+    if (slotIndex >= shard.slots.size())
+        return nullptr;
+
+    const Slot& slot = shard.slots[slotIndex];
+    if (slot.generation != GenerationOf(id))
+        return nullptr;
+
+    return slot.session;
+}
+
+void SessionRegistry::Clear()
+{
+    for (Shard& shard : _shards)
+    {
+        std::vector<SessionRef> removed;
+        {
+            std::lock_guard<std::mutex> lock(shard.lock);
+            for (uint32_t i = 0; i < shard.slots.size(); i++)
+            {
+                Slot& slot = shard.slots[i];
+                if (slot.session == nullptr)
+                    continue;
+
+                if (++slot.generation == 0)
+                    slot.generation = 1;
+
+                removed.push_back(std::move(slot.session));
+                shard.freeSlots.push_back(i);
+            }
+            shard.snapshot = nullptr;
+        }
+
+        _count.fetch_sub(static_cast<int32_t>(removed.size()), std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<const std::vector<SessionRef>> SessionRegistry::GetSnapshot(Shard& shard)
+{
+    std::lock_guard<std::mutex> lock(shard.lock);
+
+    // / ٸ   ״  
+    if (shard.snapshot == nullptr)
+    {
+        auto snapshot = std::make_shared<std::vector<SessionRef>>();
+        snapshot->reserve(shard.slots.size() - shard.freeSlots.size());
+        for (const Slot& slot : shard.slots)
+        {
+            if (slot.session)
+                snapshot->push_back(slot.session);
+        }
+        shard.snapshot = std::move(snapshot);
+    }
+
+    return shard.snapshot;
+}
@@ -1,8 +1,24 @@
 #pragma once
+#include "LockFreeQueue.h"
 
+/*-----------------
+	ThreadManager
+------------------*/
+// Launch : ݹ ϳ  带 
+// StartWorkers : ۾ ġ Ǯ. Ŀ Chase-Lev  ΰ, ڱ   ٸ Ŀ  ģ
+// - Ŀ ȿ Post  ۾ ڱ , ۿ Post  ۾  ť 
+// - RunIoWorker  I/O  ϳ io_context Ϸ CPU ۾  ó  ִ
 class ThreadManager
 {
+	enum
+	{
+		IO_TASK_BATCH = 32,		// RunIoWorker  I/O  ٽ   óϴ ۾ 
+		GLOBAL_QUEUE_TICK = 64,	// Ŀ / I/O  GlobalQueue        (ms)
+	};
+
 public:
+	using Task = std::function<void()>;
+
 	ThreadManager();
 	~ThreadManager();
 
@@ -12,11 +28,96 @@ public:
 	static void InitTLS();
 	static void DestroyTLS();
 
+	static bool SetAffinity(int32_t cpu);
+
+	// LEndTickCount  GlobalQueue  Ѿ JobQueue  Ѵ. ϳ  true
+	static bool DoGlobalQueueWork();
+
+	/* Task Pool */
+	// workerCount  0 ϸ ھ ŭ
+	void	StartWorkers(int32_t workerCount = 0, bool pinThreads = false);
+	//  ۾ ȣ 忡  ϰ Ŀ 
+	void	StopWorkers();
+	int32_t	GetWorkerCount() const;
+	bool	IsWorkerRunning() const { return _workersRunning.load(); }
+
+	void	Post(Task task);
+	// ڰ ִ Ŀ ϳ . ڴ Ŀ  I/O ϷḦ ٸ RunIoWorker ϳ  (  ڿ θ)
+	void	WakeWorker();
+
+	template<typename F>
+	auto	Submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+	{
+		using ResultType = std::invoke_result_t<std::decay_t<F>>;
+
+		// std::function   ؾ ؼ packaged_task  shared_ptr  Ѵ
+		auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+		std::future<ResultType> future = task->get_future();
+		Post([task]() { (*task)(); });
+		return future;
+	}
+
+	// ۾ ϳ  ϸ true (Ŀ ƴ 忡 ȣ )
+	bool	RunOneTask();
+	// ioc    I/O Ϸ Ǯ ۾  óѴ (ioc.run()  ȣ)
+	void	RunIoWorker(asio::io_context& ioc);
+
+private:
+	struct TaskNode
+	{
+		Task callback;
+	};
+
+	struct Worker
+	{
+		WorkStealingDeque<TaskNode*>	deque;
+		std::thread						thread;
+	};
+
+	struct WorkerList
+	{
+		std::vector<std::unique_ptr<Worker>>	workers;
+	};
+
+	// run_one  ڰ ִ RunIoWorker.    io_context   ڵ鷯 ִ´
+	struct IoWaiter
+	{
+		asio::io_context*	ioc;
+		std::atomic<bool>	parked = false;
+	};
+
+	void		WorkerLoop(Worker* worker);
+	bool		HasWork() const;
+	TaskNode*	FindTask(Worker* self);
+	TaskNode*	FindTaskNode(Worker* self);
+	static void	ExecuteTask(TaskNode* node);
+
 private:
 	std::mutex					_lock;
 	std::vector<std::thread>	_threads;
-};
 
+	// ġ (Ŀ / RunIoWorker / RunOneTask) _workerList    
+	// StopWorkers ڿ     Ƿ  ThreadManager    
+	std::mutex								_workersLock;	// StartWorkers / StopWorkers
+	std::atomic<WorkerList*>				_workerList = nullptr;
+	std::vector<std::unique_ptr<WorkerList>>	_workerLists;
+	std::atomic<bool>						_workersRunning = false;
+
+	std::mutex					_injectLock;
+	std::deque<TaskNode*>		_injectQueue;
+	std::atomic<int32_t>		_injectCount = 0;
+	std::atomic<int32_t>		_pendingCount = 0;		// ־  ƹ   ۾  ( +  ť)
+
+	// ڴ Ŀ ð   ٸ.  ִ  _sleepingCount   
+	std::mutex					_sleepLock;
+	std::condition_variable		_sleepCondVar;
+	std::atomic<int32_t>		_sleepingCount = 0;
+
+	//    RunIoWorker  Ÿ̸  I/O ϷḦ ٸ.  ִ  _parkedIoCount   
+	std::mutex					_ioWaitersLock;
+	std::vector<IoWaiter*>		_ioWaiters;
+	std::atomic<int32_t>		_parkedIoCount = 0;
+};
 
 ================================================================================
 // ThreadManager.cpp file content
@@ -25,6 +126,20 @@ private:
 #include "pch.h"
 #include "ThreadManager.h"
 #include "CoreTLS.h"
+#include "GlobalQueue.h"
+#include "JobQueue.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace
+{
+	//  尡  Ǯ  Ŀ (Ŀ ƴϸ nullptr)
+	thread_local ThreadManager* LWorkerOwner = nullptr;
+	thread_local void* LWorker = nullptr;
+	thread_local uint32_t LStealSeed = 0;
+}
 
 ThreadManager::ThreadManager()
 {
@@ -34,6 +149,7 @@ ThreadManager::ThreadManager()
 
 ThreadManager::~ThreadManager()
 {
+	StopWorkers();
 	Join();
 }
 
@@ -67,4 +183,304 @@ void ThreadManager::InitTLS()
 void ThreadManager::DestroyTLS()
 {
 
-}
\ No newline at end of file
+}
+
+bool ThreadManager::DoGlobalQueueWork()
+{
+	bool executed = false;
+	while (true)
+	{
+		if (JobQueue::GetTickCount() >= LEndTickCount)
+			break;
+
+		JobQueueRef jobQueue = GGlobalQueue->Pop();
+		if (jobQueue == nullptr)
+			break;
+
+		jobQueue->Execute();
+		executed = true;
+	}
+	return executed;
+}
+
+bool ThreadManager::SetAffinity(int32_t cpu)
+{
+#ifdef _WIN32
+	return ::SetThreadAffinityMask(::GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#else
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpu, &cpuSet);
+	return ::pthread_setaffinity_np(::pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#endif
+}
+
+void ThreadManager::StartWorkers(int32_t workerCount, bool pinThreads)
+{
+	const int32_t coreCount = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+	if (workerCount <= 0)
+		workerCount = coreCount;
+
+	std::lock_guard<std::mutex> guard(_workersLock);
+	if (_workerList.load() != nullptr)
+		return;
+
+	// 带      д
+	auto list = std::make_unique<WorkerList>();
+	for (int32_t i = 0; i < workerCount; i++)
+		list->workers.push_back(std::make_unique<Worker>());
+
+	_workersRunning.store(true);
+	_workerList.store(list.get());
+
+	for (int32_t i = 0; i < workerCount; i++)
+	{
+		Worker* worker = list->workers[i].get();
+		worker->thread = std::thread([this, worker, i, pinThreads, coreCount]()
+			{
+				InitTLS();
+				if (pinThreads)
+					SetAffinity(i % coreCount);
+
+				WorkerLoop(worker);
+				DestroyTLS();
+			});
+	}
+
+	_workerLists.push_back(std::move(list));
+}
+
+void ThreadManager::StopWorkers()
+{
+	std::lock_guard<std::mutex> guard(_workersLock);
+	_workersRunning.store(false);
+
+	{
+		//  (   wait ) Ŀ ȣ ġ ʵ  ļ 
+		std::lock_guard<std::mutex> sleepGuard(_sleepLock);
+	}
+	_sleepCondVar.notify_all();
+
+	if (WorkerList* list = _workerList.load())
+	{
+		for (const std::unique_ptr<Worker>& worker : list->workers)
+		{
+			if (worker->thread.joinable())
+				worker->thread.join();
+		}
+	}
+
+	//  ߿  Post  ۾ ⼭  (Ŀ  Post   쵵)
+	while (RunOneTask())
+	{
+	}
+
+	//    Ŀ Ƿ  Post   ťθ 
+	_workerList.store(nullptr);
+}
+
+int32_t ThreadManager::GetWorkerCount() const
+{
+	WorkerList* list = _workerList.load();
+	return list ? static_cast<int32_t>(list->workers.size()) : 0;
+}
+
+void ThreadManager::Post(Task task)
+{
+	TaskNode* node = new TaskNode{ std::move(task) };
+	_pendingCount.fetch_add(1);
+
+	if (LWorkerOwner == this)
+	{
+		static_cast<Worker*>(LWorker)->deque.Push(node);
+	}
+	else
+	{
+		std::lock_guard<std::mutex> guard(_injectLock);
+		_injectQueue.push_back(node);
+		_injectCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	WakeWorker();
+}
+
+void ThreadManager::WakeWorker()
+{
+	//   ڿ Ƿ, ⼭ 0 ̸    Ŀ      
+	if (_sleepingCount.load() > 0)
+	{
+		{
+			std::lock_guard<std::mutex> guard(_sleepLock);
+		}
+		_sleepCondVar.notify_one();
+		return;
+	}
+
+	// RunIoWorker   . parked     Ƿ ⼭ 0 ̸    
+	if (_parkedIoCount.load() == 0)
+		return;
+
+	std::lock_guard<std::mutex> guard(_ioWaitersLock);
+	for (IoWaiter* waiter : _ioWaiters)
+	{
+		if (waiter->parked.load() && waiter->parked.exchange(false))
+		{
+			asio::post(*waiter->ioc, []() {});
+			break;
+		}
+	}
+}
+
+bool ThreadManager::RunOneTask()
+{
+	Worker* self = LWorkerOwner == this ? static_cast<Worker*>(LWorker) : nullptr;
+
+	TaskNode* node = FindTask(self);
+	if (node == nullptr)
+		return false;
+
+	ExecuteTask(node);
+	return true;
+}
+
+void ThreadManager::RunIoWorker(asio::io_context& ioc)
+{
+	IoWaiter waiter{ &ioc };
+	{
+		std::lock_guard<std::mutex> guard(_ioWaitersLock);
+		_ioWaiters.push_back(&waiter);
+	}
+
+	while (ioc.stopped() == false)
+	{
+		const size_t handled = ioc.poll();
+
+		int32_t executed = 0;
+		while (executed < IO_TASK_BATCH && RunOneTask())
+			executed++;
+
+		if (GGlobalQueue->IsEmpty() == false)
+		{
+			LEndTickCount = JobQueue::GetTickCount() + GLOBAL_QUEUE_TICK;
+			if (DoGlobalQueueWork())
+				executed++;
+			LEndTickCount = 0;
+		}
+
+		//      I/O Ϸᳪ WakeWorker  ִ  ڵ鷯   ܴ
+		if (handled == 0 && executed == 0)
+		{
+			waiter.parked.store(true);
+			_parkedIoCount.fetch_add(1);
+
+			if (HasWork() == false)
+				ioc.run_one();
+
+			waiter.parked.store(false);
+			_parkedIoCount.fetch_sub(1);
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(_ioWaitersLock);
+	std::erase(_ioWaiters, &waiter);
+}
+
+void ThreadManager::WorkerLoop(Worker* worker)
+{
+	LWorkerOwner = this;
+	LWorker = worker;
+
+	while (_workersRunning.load(std::memory_order_relaxed))
+	{
+		if (TaskNode* node = FindTask(worker))
+		{
+			ExecuteTask(node);
+			continue;
+		}
+
+		// Ǯ ۾   Ѿ JobQueue  ̾ Ѵ
+		if (GGlobalQueue->IsEmpty() == false)
+		{
+			LEndTickCount = JobQueue::GetTickCount() + GLOBAL_QUEUE_TICK;
+			const bool executed = DoGlobalQueueWork();
+			LEndTickCount = 0;
+			if (executed)
+				continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepLock);
+		_sleepingCount.fetch_add(1);
+		_sleepCondVar.wait(lock, [this]() { return _workersRunning.load() == false || HasWork(); });
+		_sleepingCount.fetch_sub(1);
+	}
+
+	// ڱ   ۾ StopWorkers  ļ 
+	LWorkerOwner = nullptr;
+	LWorker = nullptr;
+}
+
+bool ThreadManager::HasWork() const
+{
+	return _pendingCount.load() > 0 || GGlobalQueue->IsEmpty() == false;
+}
+
+ThreadManager::TaskNode* ThreadManager::FindTask(Worker* self)
+{
+	TaskNode* node = FindTaskNode(self);
+	if (node)
+		_pendingCount.fetch_sub(1);
+	return node;
+}
+
+ThreadManager::TaskNode* ThreadManager::FindTaskNode(Worker* self)
+{
+	if (self)
+	{
+		if (TaskNode* node = self->deque.Pop())
+			return node;
+	}
+
+	if (_injectCount.load(std::memory_order_relaxed) > 0)
+	{
+		std::lock_guard<std::mutex> guard(_injectLock);
+		if (_injectQueue.empty() == false)
+		{
+			TaskNode* node = _injectQueue.front();
+			_injectQueue.pop_front();
+			_injectCount.fetch_sub(1, std::memory_order_relaxed);
+			return node;
+		}
+	}
+
+	WorkerList* list = _workerList.load();
+	if (list == nullptr)
+		return nullptr;
+
+	const size_t workerCount = list->workers.size();
+
+	// Ź  Ŀ ġ ʵ  ġ ´ (xorshift)
+	if (LStealSeed == 0)
+		LStealSeed = static_cast<uint32_t>(LThreadId) * 2654435761u + 1;
+	LStealSeed ^= LStealSeed << 13;
+	LStealSeed ^= LStealSeed >> 17;
+	LStealSeed ^= LStealSeed << 5;
+
+	const size_t start = LStealSeed % workerCount;
+	for (size_t i = 0; i < workerCount; i++)
+	{
+		Worker* victim = list->workers[(start + i) % workerCount].get();
+		if (victim == self)
+			continue;
+
+		if (TaskNode* node = victim->deque.Steal())
+			return node;
+	}
+
+	return nullptr;
+}
+
+void ThreadManager::ExecuteTask(TaskNode* node)
+{
+	node->callback();
+	delete node;
+}
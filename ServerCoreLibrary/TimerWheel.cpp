@@ -0,0 +1,233 @@
+#include "pch.h"
+#include "TimerWheel.h"
+
+asio::execution_context::id TimerWheel::id;
+
+TimerWheel::TimerWheel(asio::execution_context& context)
+    : asio::execution_context::service(context)
+    , _ioc(static_cast<asio::io_context&>(context))
+    , _epoch(std::chrono::steady_clock::now())
+    , _timer(_ioc)
+{
+    _slots.fill(INVALID_INDEX);
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+TimerId TimerWheel::Schedule(std::chrono::milliseconds delay, Callback callback)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_shutdown)
+        return 0;
+
+    //  ־ٸ  ƽ ϳ  ʿ   ð 
+    if (_count == 0)
+        _currentTick = std::max(_currentTick, NowTick());
+
+    uint32_t index;
+    if (_freeNodes.empty() == false)
+    {
+        index = _freeNodes.back();
+        _freeNodes.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(_nodes.size());
+        _nodes.emplace_back();
+    }
+
+    const uint64_t ticks = std::max<int64_t>(1, (delay.count() + TICK_MS - 1) / TICK_MS);
+
+    // ƽ ó з _currentTick  ó ־  ð  (и ŭ   ʰ, ū ̴ Link  ܿ д)
+    Node& node = _nodes[index];
+    node.expireTick = std::max(_currentTick, NowTick()) + ticks;
+    node.callback = std::move(callback);
+    Link(index);
+    _count++;
+
+    if (_ticking == false)
+    {
+        _ticking = true;
+        RegisterTick();
+    }
+
+    return MakeId(index, node.generation);
+}
+
+bool TimerWheel::Cancel(TimerId timerId)
+{
+    Callback callback;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+
+        const uint32_t index = static_cast<uint32_t>(timerId & 0xFFFFFFFF);
+        const uint32_t generation = static_cast<uint32_t>(timerId >> 32);
+        if (timerId == 0 || index >= _nodes.size())
+            return false;
+
+        Node& node = _nodes[index];
+        if (node.generation != generation || node.slot == INVALID_INDEX)
+            return false;
+
+        Unlink(index);
+        callback = std::move(node.callback);
+        node.generation++;
+        _freeNodes.push_back(index);
+        _count--;
+    }
+
+    // ݹ  ִ ü  ۿ ´
+    return true;
+}
+
+int32_t TimerWheel::Count()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _count;
+}
+
+void TimerWheel::shutdown()
+{
+    std::vector<Node> nodes;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _shutdown = true;
+        _ticking = false;
+        _nodes.swap(nodes);
+        _freeNodes.clear();
+        _slots.fill(INVALID_INDEX);
+        _count = 0;
+    }
+
+    _timer.cancel();
+}
+
+uint64_t TimerWheel::NowTick() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _epoch).count() / TICK_MS;
+}
+
+void TimerWheel::Link(uint32_t index)
+{
+    Node& node = _nodes[index];
+
+    //  ƽ   . ĭ  ƽ ش ڸ Ʈ Ѵ
+    const uint64_t delta = node.expireTick > _currentTick ? node.expireTick - _currentTick : 0;
+    uint32_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delta >= (1ull << (LEVEL_BITS * (level + 1))))
+        level++;
+
+    uint64_t expireTick = node.expireTick;
+    if (delta >= (1ull << (LEVEL_BITS * LEVEL_COUNT)))
+        expireTick = _currentTick + (1ull << (LEVEL_BITS * LEVEL_COUNT)) - 1;
+
+    const uint32_t slot = level * LEVEL_SIZE + static_cast<uint32_t>((expireTick >> (LEVEL_BITS * level)) & LEVEL_MASK);
+
+    node.slot = slot;
+    node.prev = INVALID_INDEX;
+    node.next = _slots[slot];
+    if (node.next != INVALID_INDEX)
+        _nodes[node.next].prev = index;
+    _slots[slot] = index;
+}
+
+void TimerWheel::Unlink(uint32_t index)
+{
+    Node& node = _nodes[index];
+
+    if (node.prev != INVALID_INDEX)
+        _nodes[node.prev].next = node.next;
+    else
+        _slots[node.slot] = node.next;
+
+    if (node.next != INVALID_INDEX)
+        _nodes[node.next].prev = node.prev;
+
+    node.prev = node.next = node.slot = INVALID_INDEX;
+}
+
+void TimerWheel::Cascade(uint32_t level)
+{
+    const uint32_t index = static_cast<uint32_t>((_currentTick >> (LEVEL_BITS * level)) & LEVEL_MASK);
+
+    //   ; ̹ ĭ  尡  ʴ´
+    if (index == 0 && level + 1 < LEVEL_COUNT)
+        Cascade(level + 1);
+
+    const uint32_t slot = level * LEVEL_SIZE + index;
+    uint32_t nodeIndex = _slots[slot];
+    _slots[slot] = INVALID_INDEX;
+
+    while (nodeIndex != INVALID_INDEX)
+    {
+        const uint32_t next = _nodes[nodeIndex].next;
+        Link(nodeIndex);
+        nodeIndex = next;
+    }
+}
+
+void TimerWheel::Advance(uint64_t targetTick, std::vector<Callback>& expired)
+{
+    while (_currentTick < targetTick && _count > 0)
+    {
+        _currentTick++;
+
+        const uint32_t index = static_cast<uint32_t>(_currentTick & LEVEL_MASK);
+        if (index == 0)
+            Cascade(1);
+
+        uint32_t nodeIndex = _slots[index];
+        _slots[index] = INVALID_INDEX;
+
+        while (nodeIndex != INVALID_INDEX)
+        {
+            Node& node = _nodes[nodeIndex];
+            const uint32_t next = node.next;
+
+            node.prev = node.next = node.slot = INVALID_INDEX;
+            node.generation++;
+            expired.push_back(std::move(node.callback));
+            _freeNodes.push_back(nodeIndex);
+            _count--;
+
+            nodeIndex = next;
+        }
+    }
+
+    // Ÿ̸Ӱ   ƽ ǳʶڴ
+    _currentTick = std::max(_currentTick, targetTick);
+}
+
+void TimerWheel::RegisterTick()
+{
+    _timer.expires_after(std::chrono::milliseconds(TICK_MS));
+    _timer.async_wait([this](const std::error_code& error)
+        {
+            if (error)
+                return;
+
+            OnTick();
+        });
+}
+
+void TimerWheel::OnTick()
+{
+    std::vector<Callback> expired;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (_shutdown)
+            return;
+
+        Advance(NowTick(), expired);
+
+        if (_count > 0)
+            RegisterTick();
+        else
+            _ticking = false;
+    }
+
+    for (Callback& callback : expired)
+        callback();
+}
@@ -0,0 +1,69 @@
+#include "pch.h"
+#include "Test.h"
+#include <cstdlib>
+#include <new>
+
+// ׽Ʈ    operator new / delete  ٲ㼭  Ҵ  
+// ̺귯 asio  θ new   Ƿ,   ڵ鷯 control block Ҵ絵 
+namespace
+{
+    std::atomic<uint64_t> GHeapAllocCount = 0;
+
+    void* Allocate(size_t size)
+    {
+        GHeapAllocCount.fetch_add(1, std::memory_order_relaxed);
+        if (void* pointer = std::malloc(size == 0 ? 1 : size))
+            return pointer;
+        throw std::bad_alloc();
+    }
+
+    void* AllocateAligned(size_t size, std::align_val_t alignment)
+    {
+        GHeapAllocCount.fetch_add(1, std::memory_order_relaxed);
+        const size_t align = static_cast<size_t>(alignment);
+#ifdef _MSC_VER
+        void* pointer = ::_aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        void* pointer = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (pointer)
+            return pointer;
+        throw std::bad_alloc();
+    }
+
+    void FreeAligned(void* pointer)
+    {
+#ifdef _MSC_VER
+        ::_aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+uint64_t GetHeapAllocCount()
+{
+    return GHeapAllocCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size) { return Allocate(size); }
+void* operator new[](size_t size) { return Allocate(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { try { return Allocate(size); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { try { return Allocate(size); } catch (...) { return nullptr; } }
+void* operator new(size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; } }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { try { return AllocateAligned(size, alignment); } catch (...) { return nullptr; } }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(pointer); }
@@ -0,0 +1,150 @@
+#include "pch.h"
+#include "Test.h"
+#include "CoroutineSession.h"
+#include "Service.h"
+#include "AsioCore.h"
+#include "ThreadManager.h"
+
+namespace
+{
+    enum : int64_t
+    {
+        HIGH_WATERMARK = 64 * 1024,
+        LOW_WATERMARK = 16 * 1024,
+    };
+
+    enum : uint16_t
+    {
+        TEST_PORT = 7790,
+        TEST_PACKET_SIZE = 8 * 1024,
+    };
+
+    bool WaitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout,
+        std::chrono::milliseconds interval = std::chrono::milliseconds(5))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (condition() == false)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+            std::this_thread::sleep_for(interval);
+        }
+        return true;
+    }
+
+    struct StalledState
+    {
+        std::atomic<bool>       finished = false;
+        std::atomic<int64_t>    sent = 0;       // AsyncSend  ƿ Ƚ
+        std::mutex              lock;
+        std::weak_ptr<Session>  connected;  // Listener  accept  ̸      ʴ´
+    };
+
+    // 밡  Ƿ  ۰  ۽ ť high watermark  Ѱ AsyncSend  
+    class StalledSession : public CoroutineSession
+    {
+    public:
+        StalledSession(asio::io_context& ioc, StalledState& state)
+            : CoroutineSession(ioc), _state(state)
+        {
+        }
+
+    protected:
+        virtual asio::awaitable<void> Run() override
+        {
+            {
+                std::lock_guard<std::mutex> guard(_state.lock);
+                _state.connected = GetSessionRef();
+            }
+
+            while (true)
+            {
+                const bool sent = co_await AsyncSend(MakePacket());
+                if (sent == false)
+                    break;
+                _state.sent++;
+            }
+            _state.finished = true;
+        }
+
+    private:
+        static std::shared_ptr<SendBuffer> MakePacket()
+        {
+            std::shared_ptr<SendBuffer> sendBuffer = GSendBufferManager->Open(TEST_PACKET_SIZE);
+            PacketHeader header{ TEST_PACKET_SIZE, 1 };
+            ::memset(sendBuffer->Buffer(), 0, TEST_PACKET_SIZE);
+            ::memcpy(sendBuffer->Buffer(), &header, sizeof(header));
+            sendBuffer->Close(TEST_PACKET_SIZE);
+            return sendBuffer;
+        }
+
+    private:
+        StalledState&   _state;
+    };
+}
+
+// ü  AsyncSend  Disconnect   Run  , ǵ Ǿ Ѵ
+bool TestAsyncSendWakesOnDisconnect()
+{
+    AsiocCore core;
+    StalledState state;
+
+    const NetAddress address("127.0.0.1", TEST_PORT);
+    auto service = std::make_shared<ServerService>(core.GetIoContext(), address,
+        [&state](asio::io_context& ioc) { return std::make_shared<StalledSession>(ioc, state); });
+    service->SetSendBackpressure(HIGH_WATERMARK, LOW_WATERMARK, SendBackpressurePolicy::Notify);
+    TEST_CHECK(service->Start());
+
+    std::thread ioThread([&core]()
+        {
+            ThreadManager::InitTLS();
+            core.Run();
+            ThreadManager::DestroyTLS();
+        });
+
+    // Ӹ ϰ  ʴ 
+    asio::io_context clientIoc;
+    asio::ip::tcp::socket client(clientIoc);
+    std::error_code ec;
+    client.connect(address.GetEndpoint(), ec);
+
+    // Ŀ ۽ ۰ ø鼭 ť high watermark Ʒ   Ƿ, ť ũ 
+    // AsyncSend  ѵ ƿ ʴ  ü ɷ  
+    int64_t lastSent = -1;
+    bool passed = !ec
+        && WaitFor([&]()
+            {
+                const int64_t sent = state.sent.load();
+                const bool stalled = sent == lastSent && service->GetQueuedSendBytes() > LOW_WATERMARK;
+                lastSent = sent;
+                return stalled;
+            }, std::chrono::seconds(10), std::chrono::milliseconds(200));
+
+    SessionRef session;
+    {
+        std::lock_guard<std::mutex> guard(state.lock);
+        session = state.connected.lock();
+    }
+
+    if (passed && session)
+    {
+        session->Disconnect("Test");
+        session = nullptr;
+
+        passed = WaitFor([&]() { return state.finished.load(); }, std::chrono::seconds(2))
+            && WaitFor([&]() { std::lock_guard<std::mutex> guard(state.lock); return state.connected.expired(); }, std::chrono::seconds(2))
+            && service->GetQueuedSendBytes() == 0;
+    }
+    else
+    {
+        passed = false;
+    }
+
+    client.close(ec);
+    service->CloseService();
+    core.Stop();
+    ioThread.join();
+
+    TEST_CHECK(passed);
+    return true;
+}
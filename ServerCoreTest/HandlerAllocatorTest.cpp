@@ -0,0 +1,107 @@
+#include "pch.h"
+#include "Test.h"
+#include "Session.h"
+#include "Service.h"
+#include "AsioCore.h"
+#include "ThreadManager.h"
+#include "Metrics.h"
+
+namespace
+{
+    enum : uint16_t
+    {
+        TEST_PORT = 7791,
+        TEST_PACKET_SIZE = 256,
+        TEST_PACKET_ID = 1,
+    };
+
+    enum : int32_t
+    {
+        WARMUP_ROUNDS = 64,         // 4KB ۽ ûũ     (ûũ ü   ϱ ĳÿ ä)
+        MEASURE_ROUNDS = 1000,
+    };
+
+    //  Ŷ ״ ش
+    class EchoSession : public PacketSession
+    {
+    public:
+        EchoSession(asio::io_context& ioc) : PacketSession(ioc) {}
+
+    protected:
+        virtual void OnRecvPacket(BYTE* buffer, int32_t len) override
+        {
+            std::shared_ptr<SendBuffer> sendBuffer = GSendBufferManager->Open(len);
+            ::memcpy(sendBuffer->Buffer(), buffer, len);
+            sendBuffer->Close(len);
+            Send(sendBuffer);
+        }
+    };
+
+    // Ŷ ϳ   ũ    ٸ
+    bool Exchange(asio::ip::tcp::socket& client, std::array<BYTE, TEST_PACKET_SIZE>& packet)
+    {
+        std::error_code ec;
+        asio::write(client, asio::buffer(packet), ec);
+        if (ec)
+            return false;
+
+        std::array<BYTE, TEST_PACKET_SIZE> reply;
+        asio::read(client, asio::buffer(reply), ec);
+        return !ec && reply == packet;
+    }
+}
+
+//  ڸ    / ۽  Ҵ ϳ  Ѵ
+//  Ҵ   operator new   (  ڵ鷯, control block  )
+// HandlerHeapAllocs   ڵ鷯    츦  ȮѴ
+bool TestHandlerAllocatorSteadyState()
+{
+    AsiocCore core;
+
+    const NetAddress address("127.0.0.1", TEST_PORT);
+    auto service = std::make_shared<ServerService>(core.GetIoContext(), address,
+        [](asio::io_context& ioc) { return std::make_shared<EchoSession>(ioc); });
+    TEST_CHECK(service->Start());
+
+    std::thread ioThread([&core]()
+        {
+            ThreadManager::InitTLS();
+            core.Run();
+            ThreadManager::DestroyTLS();
+        });
+
+    asio::io_context clientIoc;
+    asio::ip::tcp::socket client(clientIoc);
+    std::error_code ec;
+    client.connect(address.GetEndpoint(), ec);
+
+    std::array<BYTE, TEST_PACKET_SIZE> packet;
+    for (int32_t i = 0; i < TEST_PACKET_SIZE; i++)
+        packet[i] = static_cast<BYTE>(i);
+    PacketHeader header{ TEST_PACKET_SIZE, TEST_PACKET_ID };
+    ::memcpy(packet.data(), &header, sizeof(header));
+
+    // accept  ù   غ  ں 
+    bool passed = !ec;
+    for (int32_t i = 0; passed && i < WARMUP_ROUNDS; i++)
+        passed = Exchange(client, packet);
+
+    const uint64_t handlerHeapAllocsBefore = Metrics::Snapshot().Get(MetricCounter::HandlerHeapAllocs);
+    const uint64_t heapAllocsBefore = GetHeapAllocCount();
+
+    for (int32_t i = 0; passed && i < MEASURE_ROUNDS; i++)
+        passed = Exchange(client, packet);
+
+    const uint64_t heapAllocsAfter = GetHeapAllocCount();
+    const uint64_t handlerHeapAllocsAfter = Metrics::Snapshot().Get(MetricCounter::HandlerHeapAllocs);
+
+    client.close(ec);
+    service->CloseService();
+    core.Stop();
+    ioThread.join();
+
+    TEST_CHECK(passed);
+    TEST_CHECK(heapAllocsAfter - heapAllocsBefore == 0);
+    TEST_CHECK(handlerHeapAllocsAfter - handlerHeapAllocsBefore == 0);
+    return true;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// ӿũ  main  ʷ . ϸ ޽  false  ش
+#define TEST_CHECK(condition)                                                           \
+    do                                                                                  \
+    {                                                                                   \
+        if (!(condition))                                                               \
+        {                                                                               \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition << std::endl;   \
+            return false;                                                               \
+        }                                                                               \
+    } while (false)
+
+// μ ۵   operator new  Ҹ Ƚ (AllocationCounter.cpp)
+uint64_t GetHeapAllocCount();
+
+bool TestAsyncSendWakesOnDisconnect();
+bool TestHandlerAllocatorSteadyState();
@@ -0,0 +1,30 @@
+#include "pch.h"
+#include "Test.h"
+
+int main()
+{
+    CoreGlobal coreGlobal;
+
+    struct TestCase
+    {
+        const char* name;
+        bool        (*func)();
+    };
+
+    const TestCase tests[] =
+    {
+        { "AsyncSendWakesOnDisconnect", &TestAsyncSendWakesOnDisconnect },
+        { "HandlerAllocatorSteadyState", &TestHandlerAllocatorSteadyState },
+    };
+
+    int failed = 0;
+    for (const TestCase& test : tests)
+    {
+        const bool passed = test.func();
+        std::cout << (passed ? "[PASS] " : "[FAIL] ") << test.name << std::endl;
+        if (passed == false)
+            failed++;
+    }
+
+    return failed;
+}